@@ -0,0 +1,204 @@
+/******************************************************************************
+ * File:        bit_grid.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Compares aoc::BitGrid with a byte-per-cell grid on a day 24
+ *              style frontier expansion and a day 23 style 8-neighbor check,
+ *              on boards much larger than the real inputs.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <array>    // for array
+#include <chrono>   // for steady_clock, duration
+#include <cstdint>  // for uint8_t
+#include <iomanip>  // for setw, setprecision
+#include <iostream> // for cout, fixed
+#include <random>   // for mt19937, bernoulli_distribution
+#include <utility>  // for pair, swap
+#include <vector>   // for vector
+
+namespace aoc::bench {
+
+constexpr std::array<Delta, 4> orthogonal{Delta(1, 0), Delta(-1, 0),
+                                          Delta(0, 1), Delta(0, -1)};
+constexpr std::array<Delta, 8> all_neighbors{
+    Delta(1, 0),  Delta(-1, 0), Delta(0, 1),  Delta(0, -1),
+    Delta(1, 1),  Delta(1, -1), Delta(-1, 1), Delta(-1, -1)};
+
+// one byte per cell, with a border of empty cells on each side
+class ByteGrid {
+    int w, h;
+    std::vector<std::uint8_t> cells;
+
+  public:
+    ByteGrid(int width, int height)
+        : w(width), h(height),
+          cells(static_cast<std::size_t>(width + 2) * (height + 2), 0) {}
+    std::uint8_t &operator[](const Pos &pos) {
+        return cells[static_cast<std::size_t>(pos.y + 1) * (w + 2) + pos.x +
+                     1];
+    }
+    std::uint8_t operator[](const Pos &pos) const {
+        return cells[static_cast<std::size_t>(pos.y + 1) * (w + 2) + pos.x +
+                     1];
+    }
+    int width() const { return w; }
+    int height() const { return h; }
+    int count() const {
+        int total = 0;
+        for (std::uint8_t c : cells) {
+            total += c;
+        }
+        return total;
+    }
+};
+
+// measures the time since construction, excluding the board setup
+class Stopwatch {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+  public:
+    double elapsed() const {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+};
+
+template <typename Grid>
+void fill_random(Grid &grid, double density, unsigned seed) {
+    std::mt19937 rng{seed};
+    std::bernoulli_distribution dist{density};
+    for (int y = 0; y < grid.height(); ++y) {
+        for (int x = 0; x < grid.width(); ++x) {
+            if (dist(rng)) {
+                if constexpr (std::is_same_v<Grid, BitGrid>) {
+                    grid.set(Pos(x, y));
+                } else {
+                    grid[Pos(x, y)] = 1;
+                }
+            }
+        }
+    }
+}
+
+// reachable cells after each step: (curr | 4 neighbors) & ~walls
+int frontier_bytes(int size, int steps, double &seconds) {
+    ByteGrid walls(size, size), curr(size, size), next(size, size);
+    fill_random(walls, 0.3, 24);
+    walls[Pos(0, 0)] = 0;
+    curr[Pos(0, 0)] = 1;
+    Stopwatch timer;
+    for (int step = 0; step < steps; ++step) {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                Pos pos{x, y};
+                std::uint8_t reached = curr[pos];
+                for (const Delta &delta : orthogonal) {
+                    reached |= curr[pos + delta];
+                }
+                next[pos] = reached & ~walls[pos] & 1;
+            }
+        }
+        std::swap(curr, next);
+    }
+    seconds = timer.elapsed();
+    return curr.count();
+}
+
+int frontier_bits(int size, int steps, double &seconds) {
+    BitGrid walls(size, size), curr(size, size), next(size, size);
+    fill_random(walls, 0.3, 24);
+    walls.reset(Pos(0, 0));
+    curr.set(Pos(0, 0));
+    Stopwatch timer;
+    for (int step = 0; step < steps; ++step) {
+        next = curr;
+        for (const Delta &delta : orthogonal) {
+            next.or_shifted(curr, delta);
+        }
+        next.and_not(walls);
+        std::swap(curr, next);
+    }
+    seconds = timer.elapsed();
+    return curr.count();
+}
+
+// number of occupied cells with at least one occupied neighbor
+int neighbors_bytes(int size, int steps, double &seconds) {
+    ByteGrid elves(size, size);
+    fill_random(elves, 0.2, 23);
+    int total = 0;
+    Stopwatch timer;
+    for (int step = 0; step < steps; ++step) {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                Pos pos{x, y};
+                std::uint8_t crowded = 0;
+                for (const Delta &delta : all_neighbors) {
+                    crowded |= elves[pos + delta];
+                }
+                total += crowded & elves[pos];
+            }
+        }
+    }
+    seconds = timer.elapsed();
+    return total;
+}
+
+int neighbors_bits(int size, int steps, double &seconds) {
+    BitGrid elves(size, size), crowded(size, size);
+    fill_random(elves, 0.2, 23);
+    int total = 0;
+    Stopwatch timer;
+    for (int step = 0; step < steps; ++step) {
+        crowded.clear();
+        for (const Delta &delta : all_neighbors) {
+            crowded.or_shifted(elves, delta);
+        }
+        crowded &= elves;
+        total += crowded.count();
+    }
+    seconds = timer.elapsed();
+    return total;
+}
+
+template <typename BytesFunc, typename BitsFunc>
+void report(const char *name, int size, int steps, BytesFunc bytes_func,
+            BitsFunc bits_func) {
+    double bytes_time, bits_time;
+    int bytes_result = bytes_func(size, steps, bytes_time);
+    int bits_result = bits_func(size, steps, bits_time);
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::setw(6) << size << std::fixed << std::setprecision(4)
+              << std::setw(10) << bytes_time << std::setw(10) << bits_time
+              << std::setprecision(1) << std::setw(8)
+              << bytes_time / bits_time << "x";
+    if (bytes_result != bits_result) {
+        std::cout << "  MISMATCH: " << bytes_result << " != " << bits_result;
+    }
+    std::cout << "\n";
+}
+
+} // namespace aoc::bench
+
+int main() {
+    using namespace aoc::bench;
+#ifdef __AVX2__
+    std::cout << "BitGrid using AVX2\n";
+#else
+    std::cout << "BitGrid using 64-bit words\n";
+#endif
+    std::cout << "workload    size     bytes   BitGrid speedup\n";
+    constexpr std::array<std::pair<int, int>, 3> sizes{
+        {{128, 1000}, {1024, 100}, {4096, 20}}};
+    for (auto [size, steps] : sizes) {
+        report("frontier", size, steps, frontier_bytes, frontier_bits);
+    }
+    for (auto [size, steps] : sizes) {
+        report("neighbors", size, steps, neighbors_bytes, neighbors_bits);
+    }
+    return 0;
+}
@@ -0,0 +1,752 @@
+/******************************************************************************
+ * File:        gen_input.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Generates valid synthetic inputs for every day, at a multiple
+ *              of the size of the real inputs, for scaling benchmarks.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <algorithm>  // for shuffle, min, max, clamp
+#include <array>      // for array
+#include <cmath>      // for sqrt, lround
+#include <cstdlib>    // for abs, getenv
+#include <functional> // for function
+#include <iostream>   // for cout, cerr, ostream
+#include <numeric>    // for iota
+#include <random>     // for mt19937_64, uniform_int_distribution, ...
+#include <string>     // for string, stod, stoul, to_string
+#include <vector>     // for vector
+
+namespace aoc::gen {
+
+using Rng = std::mt19937_64;
+
+// inclusive on both ends
+long uniform(Rng &rng, long lo, long hi) {
+    return std::uniform_int_distribution<long>{lo, hi}(rng);
+}
+
+bool chance(Rng &rng, double p) { return std::bernoulli_distribution{p}(rng); }
+
+// scales a count from the real input, keeping at least `min`
+long scaled(double scale, long real_count, long min = 1) {
+    return std::max(min, std::lround(real_count * scale));
+}
+
+// scales a side length, so the area grows linearly with `scale`
+int scaled_side(double scale, int real_side, int min = 1) {
+    return std::max<int>(min, std::lround(real_side * std::sqrt(scale)));
+}
+
+constexpr std::string_view LETTERS =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+std::string name_for(long index, int length) {
+    std::string name(length, 'a');
+    for (int i = length - 1; i >= 0; --i, index /= 26) {
+        name[i] = 'a' + index % 26;
+    }
+    return name;
+}
+
+// calorie counts, one elf per paragraph
+void day1(std::ostream &os, double scale, Rng &rng) {
+    for (long elf = scaled(scale, 250); elf > 0; --elf) {
+        for (long item = uniform(rng, 1, 15); item > 0; --item) {
+            os << uniform(rng, 1000, 70000) << '\n';
+        }
+        if (elf > 1) {
+            os << '\n';
+        }
+    }
+}
+
+// rock paper scissors strategy guide
+void day2(std::ostream &os, double scale, Rng &rng) {
+    for (long i = scaled(scale, 2500); i > 0; --i) {
+        os << static_cast<char>('A' + uniform(rng, 0, 2)) << ' '
+           << static_cast<char>('X' + uniform(rng, 0, 2)) << '\n';
+    }
+}
+
+// rucksacks: the halves of each line share exactly one item, and each group
+// of three lines shares exactly one badge
+void day3(std::ostream &os, double scale, Rng &rng) {
+    std::string letters{LETTERS};
+    for (long group = scaled(scale, 100); group > 0; --group) {
+        std::shuffle(letters.begin(), letters.end(), rng);
+        const char badge = letters[0];
+        for (int elf = 0; elf < 3; ++elf) {
+            // each elf gets its own 17 letters, so the badge is the only
+            // letter common to the group
+            std::string_view pool{letters.data() + 1 + 17 * elf, 17};
+            const char shared = pool[0];
+            // the halves draw from disjoint sets, plus the shared item
+            std::string first{shared, badge}, second{shared};
+            const long half = uniform(rng, 4, 16);
+            while (static_cast<long>(first.size()) < half) {
+                first += pool[uniform(rng, 1, 8)];
+            }
+            while (static_cast<long>(second.size()) < half) {
+                second += pool[uniform(rng, 9, 16)];
+            }
+            std::shuffle(first.begin(), first.end(), rng);
+            std::shuffle(second.begin(), second.end(), rng);
+            os << first << second << '\n';
+        }
+    }
+}
+
+// pairs of section assignments
+void day4(std::ostream &os, double scale, Rng &rng) {
+    for (long i = scaled(scale, 1000); i > 0; --i) {
+        long a = uniform(rng, 1, 99), b = uniform(rng, a, 99);
+        long c = uniform(rng, 1, 99), d = uniform(rng, c, 99);
+        os << a << '-' << b << ',' << c << '-' << d << '\n';
+    }
+}
+
+// crate stacks and valid rearrangement steps
+void day5(std::ostream &os, double scale, Rng &rng) {
+    constexpr int num_stacks = 9;
+    std::array<long, num_stacks> heights{};
+    const long crates = scaled(scale, 50, num_stacks);
+    for (long i = 0; i < crates; ++i) {
+        ++heights[i % num_stacks];
+    }
+    const long max_height = heights[0];
+    for (long level = max_height - 1; level >= 0; --level) {
+        std::string row{};
+        for (int s = 0; s < num_stacks; ++s) {
+            if (s > 0) {
+                row += ' ';
+            }
+            if (heights[s] > level) {
+                row += '[';
+                row += static_cast<char>('A' + uniform(rng, 0, 25));
+                row += ']';
+            } else {
+                row += "   ";
+            }
+        }
+        os << row << '\n';
+    }
+    for (int s = 1; s <= num_stacks; ++s) {
+        os << (s > 1 ? "   " : " ") << s;
+    }
+    os << " \n\n";
+    for (long i = scaled(scale, 500); i > 0; --i) {
+        // the answer is the top of each stack, so none can be left empty
+        int src;
+        do {
+            src = uniform(rng, 0, num_stacks - 1);
+        } while (heights[src] < 2);
+        int dst;
+        do {
+            dst = uniform(rng, 0, num_stacks - 1);
+        } while (dst == src);
+        long count = uniform(rng, 1, std::min(heights[src] - 1, 20L));
+        heights[src] -= count;
+        heights[dst] += count;
+        os << "move " << count << " from " << src + 1 << " to " << dst + 1
+           << '\n';
+    }
+}
+
+// datastream with the 14-character marker at the very end
+void day6(std::ostream &os, double scale, Rng &rng) {
+    std::string signal{};
+    const long length = scaled(scale, 4096, 20);
+    // only 13 distinct letters, so there can't be a start-of-message marker
+    while (static_cast<long>(signal.size()) < length - 14) {
+        signal += static_cast<char>('a' + uniform(rng, 0, 12));
+    }
+    std::string marker{"nopqrstuvwxyz"};
+    marker += signal.back() == 'a' ? 'b' : 'a';
+    std::shuffle(marker.begin(), marker.end(), rng);
+    os << signal << marker << '\n';
+}
+
+// terminal session exploring a random directory tree
+void day7(std::ostream &os, double scale, Rng &rng) {
+    const long num_dirs = scaled(scale, 180);
+    const long num_files = scaled(scale, 300);
+    std::vector<std::vector<long>> children(num_dirs);
+    for (long i = 1; i < num_dirs; ++i) {
+        children[uniform(rng, 0, i - 1)].push_back(i);
+    }
+    std::vector<long> file_counts(num_dirs);
+    for (long i = 0; i < num_files; ++i) {
+        ++file_counts[uniform(rng, 0, num_dirs - 1)];
+    }
+    // keep the total below the 70000000 disk, but above the 40000000 needed
+    // for part 2 to have an answer
+    const long max_file_size = 2 * 50000000 / num_files;
+    std::function<void(long)> visit = [&](long dir) {
+        os << "$ ls\n";
+        for (long child : children[dir]) {
+            os << "dir d" << child << '\n';
+        }
+        for (long f = 0; f < file_counts[dir]; ++f) {
+            os << uniform(rng, 1, max_file_size) << " f" << f << ".txt\n";
+        }
+        for (long child : children[dir]) {
+            os << "$ cd d" << child << '\n';
+            visit(child);
+            os << "$ cd ..\n";
+        }
+    };
+    os << "$ cd /\n";
+    visit(0);
+}
+
+// square grid of tree heights
+void day8(std::ostream &os, double scale, Rng &rng) {
+    const int side = scaled_side(scale, 99, 3);
+    for (int r = 0; r < side; ++r) {
+        std::string row(side, '0');
+        for (char &c : row) {
+            c += uniform(rng, 0, 9);
+        }
+        os << row << '\n';
+    }
+}
+
+// rope motions
+void day9(std::ostream &os, double scale, Rng &rng) {
+    for (long i = scaled(scale, 2000); i > 0; --i) {
+        os << "UDLR"[uniform(rng, 0, 3)] << ' ' << uniform(rng, 1, 20) << '\n';
+    }
+}
+
+// CPU program (only the first 240 cycles matter, so the work is constant);
+// X stays on the screen
+void day10(std::ostream &os, double scale, Rng &rng) {
+    long x = 1;
+    for (long i = scaled(scale, 146); i > 0; --i) {
+        if (chance(rng, 0.4)) {
+            os << "noop\n";
+        } else {
+            long next_x = uniform(rng, 0, 39);
+            if (next_x == x) {
+                next_x = x == 0 ? 1 : 0;
+            }
+            os << "addx " << next_x - x << '\n';
+            x = next_x;
+        }
+    }
+}
+
+// monkeys throwing items; all divisors are small primes, so their LCM stays
+// small enough that old * old can't overflow
+void day11(std::ostream &os, double scale, Rng &rng) {
+    constexpr std::array<int, 9> primes{2, 3, 5, 7, 11, 13, 17, 19, 23};
+    const long num_monkeys = scaled(scale, 8, 2);
+    const long num_items = scaled(scale, 36);
+    std::vector<std::vector<long>> items(num_monkeys);
+    for (long i = 0; i < num_items; ++i) {
+        items[uniform(rng, 0, num_monkeys - 1)].push_back(uniform(rng, 50, 99));
+    }
+    auto other_monkey = [&](long self) {
+        long target = uniform(rng, 0, num_monkeys - 2);
+        return target >= self ? target + 1 : target;
+    };
+    for (long m = 0; m < num_monkeys; ++m) {
+        if (m > 0) {
+            os << '\n';
+        }
+        os << "Monkey " << m << ":\n  Starting items:";
+        for (std::size_t i = 0; i < items[m].size(); ++i) {
+            os << (i == 0 ? " " : ", ") << items[m][i];
+        }
+        os << "\n  Operation: new = old ";
+        switch (uniform(rng, 0, 4)) {
+        case 0:
+            os << "* old";
+            break;
+        case 1:
+        case 2:
+            os << "* " << uniform(rng, 2, 19);
+            break;
+        default:
+            os << "+ " << uniform(rng, 1, 8);
+            break;
+        }
+        os << "\n  Test: divisible by " << primes[uniform(rng, 0, 8)]
+           << "\n    If true: throw to monkey " << other_monkey(m)
+           << "\n    If false: throw to monkey " << other_monkey(m) << '\n';
+    }
+}
+
+// heightmap that rises from left to right, with low pits scattered around;
+// the row through S and E is left intact so there's always a path
+void day12(std::ostream &os, double scale, Rng &rng) {
+    const int height = scaled_side(scale, 41, 3);
+    const int width = scaled_side(scale, 171, 26);
+    const int path_row = height / 2;
+    for (int y = 0; y < height; ++y) {
+        std::string row(width, 'a');
+        for (int x = 0; x < width; ++x) {
+            row[x] += std::min(25, 26 * x / width);
+            if (y != path_row && chance(rng, 0.15)) {
+                row[x] = 'a';
+            }
+        }
+        if (y == path_row) {
+            row.front() = 'S';
+            row.back() = 'E';
+        }
+        os << row << '\n';
+    }
+}
+
+void write_packet(std::ostream &os, Rng &rng, int depth) {
+    os << '[';
+    for (long i = uniform(rng, 0, 5); i > 0; --i) {
+        if (depth < 4 && chance(rng, 0.3)) {
+            write_packet(os, rng, depth + 1);
+        } else {
+            os << uniform(rng, 0, 10);
+        }
+        if (i > 1) {
+            os << ',';
+        }
+    }
+    os << ']';
+}
+
+// pairs of packets
+void day13(std::ostream &os, double scale, Rng &rng) {
+    for (long pair = scaled(scale, 150); pair > 0; --pair) {
+        write_packet(os, rng, 0);
+        os << '\n';
+        write_packet(os, rng, 0);
+        os << '\n';
+        if (pair > 1) {
+            os << '\n';
+        }
+    }
+}
+
+// rock paths below the sand source at 500,0
+void day14(std::ostream &os, double scale, Rng &rng) {
+    const int depth = scaled_side(scale, 170, 10);
+    const int half_width = depth;
+    for (long path = scaled(scale, 150); path > 0; --path) {
+        long x = uniform(rng, 500 - half_width, 500 + half_width);
+        long y = uniform(rng, 5, depth);
+        os << x << ',' << y;
+        for (long seg = uniform(rng, 1, 5); seg > 0; --seg) {
+            if (seg % 2 == 1) {
+                x = std::clamp(x + uniform(rng, -8, 8), 500L - half_width,
+                               500L + half_width);
+            } else {
+                y = std::clamp(y + uniform(rng, -8, 8), 5L, long{depth});
+            }
+            os << " -> " << x << ',' << y;
+        }
+        os << '\n';
+    }
+}
+
+// sensors that leave exactly one uncovered position in the 4000000 square:
+// four huge sensors cover everything except the gap (in rotated u = x + y,
+// v = x - y coordinates they're squares on each side of it), and the rest are
+// random sensors that stop short of it
+void day15(std::ostream &os, double scale, Rng &rng) {
+    constexpr long max_coord = 4000000;
+    const long gap_x = uniform(rng, 0, max_coord);
+    const long gap_y = uniform(rng, 0, max_coord);
+    std::vector<std::array<long, 4>> sensors{};
+    // must be odd, so the centers land on integer coordinates
+    constexpr long big = 2 * max_coord + 1;
+    const long gap_u = gap_x + gap_y, gap_v = gap_x - gap_y;
+    for (auto [du, dv] : {std::pair{-1 - big, 0L}, std::pair{1 + big, 0L},
+                          std::pair{0L, -1 - big}, std::pair{0L, 1 + big}}) {
+        long u = gap_u + du, v = gap_v + dv;
+        long x = (u + v) / 2, y = (u - v) / 2;
+        sensors.push_back({x, y, x + big, y});
+    }
+    for (long i = scaled(scale, 25, 5) - 4; i > 0; --i) {
+        long x = uniform(rng, 0, max_coord), y = uniform(rng, 0, max_coord);
+        long gap_distance = std::abs(x - gap_x) + std::abs(y - gap_y);
+        if (gap_distance < 2) {
+            ++i;
+            continue;
+        }
+        long radius = uniform(rng, 1, std::min(gap_distance - 1, 1500000L));
+        long dx = uniform(rng, -radius, radius);
+        long dy = (radius - std::abs(dx)) * (chance(rng, 0.5) ? 1 : -1);
+        sensors.push_back({x, y, x + dx, y + dy});
+    }
+    std::shuffle(sensors.begin(), sensors.end(), rng);
+    for (const auto &[x, y, bx, by] : sensors) {
+        os << "Sensor at x=" << x << ", y=" << y
+           << ": closest beacon is at x=" << bx << ", y=" << by << '\n';
+    }
+}
+
+// valves: AA plus 15 with nonzero flow, joined by corridors of zero-flow
+// valves. The solver keeps one bit per valve left after simplification, and
+// names are two letters, so only the corridors can grow (up to 676 valves).
+// AOC_GEN_FLOW_VALVES overrides the number with nonzero flow, up to 63.
+void day16(std::ostream &os, double scale, Rng &rng) {
+    const char *flow_env = std::getenv("AOC_GEN_FLOW_VALVES");
+    const int num_flow =
+        std::clamp(flow_env ? parse_int<int>(flow_env) : 15, 1, 63);
+    const long num_valves = std::min(676L, scaled(scale, 60, 2 * num_flow));
+    std::vector<std::string> names{};
+    for (long i = 0; i < 676; ++i) {
+        names.push_back(name_for(i, 2));
+        for (char &c : names.back()) {
+            c += 'A' - 'a';
+        }
+    }
+    // AA is names[0]; shuffle the rest
+    std::shuffle(names.begin() + 1, names.end(), rng);
+    std::vector<int> flow(num_valves, 0);
+    for (int i = 1; i <= num_flow; ++i) {
+        flow[i] = uniform(rng, 3, 25);
+    }
+    std::vector<std::vector<long>> tunnels(num_valves);
+    auto connect = [&](long a, long b) {
+        tunnels[a].push_back(b);
+        tunnels[b].push_back(a);
+    };
+    // a random tree over the main valves, plus a few extra edges; each edge
+    // becomes a corridor with some of the remaining valves
+    std::vector<std::pair<long, long>> edges{};
+    for (long i = 1; i <= num_flow; ++i) {
+        edges.emplace_back(uniform(rng, 0, i - 1), i);
+    }
+    for (int i = 0; i < 5; ++i) {
+        long a = uniform(rng, 0, num_flow), b = uniform(rng, 0, num_flow);
+        if (a != b) {
+            edges.emplace_back(a, b);
+        }
+    }
+    long next_valve = num_flow + 1;
+    for (std::size_t e = 0; e < edges.size(); ++e) {
+        auto [a, b] = edges[e];
+        // spread the corridor valves evenly over the edges
+        long length = (num_valves - next_valve) / (edges.size() - e);
+        long prev = a;
+        for (; length > 0; --length) {
+            connect(prev, next_valve);
+            prev = next_valve++;
+        }
+        connect(prev, b);
+    }
+    for (long v = 0; v < num_valves; ++v) {
+        os << "Valve " << names[v] << " has flow rate=" << flow[v] << "; ";
+        os << (tunnels[v].size() == 1 ? "tunnel leads to valve "
+                                      : "tunnels lead to valves ");
+        for (std::size_t t = 0; t < tunnels[v].size(); ++t) {
+            os << (t == 0 ? "" : ", ") << names[tunnels[v][t]];
+        }
+        os << '\n';
+    }
+}
+
+// jet pattern
+void day17(std::ostream &os, double scale, Rng &rng) {
+    std::string jets(scaled(scale, 10091), '<');
+    for (char &c : jets) {
+        if (chance(rng, 0.5)) {
+            c = '>';
+        }
+    }
+    os << jets << '\n';
+}
+
+// lava droplet cubes; the solver's grid only holds coordinates up to 21, so
+// the count is capped at about 2x the real input
+void day18(std::ostream &os, double scale, Rng &rng) {
+    constexpr int side = 22;
+    std::vector<int> cells(side * side * side);
+    std::iota(cells.begin(), cells.end(), 0);
+    std::shuffle(cells.begin(), cells.end(), rng);
+    const long count = std::min<long>(scaled(scale, 2800), cells.size() / 2);
+    for (long i = 0; i < count; ++i) {
+        int cell = cells[i];
+        os << cell % side << ',' << cell / side % side << ','
+           << cell / (side * side) << '\n';
+    }
+}
+
+// robot blueprints
+void day19(std::ostream &os, double scale, Rng &rng) {
+    for (long id = 1; id <= scaled(scale, 30, 3); ++id) {
+        os << "Blueprint " << id << ": Each ore robot costs "
+           << uniform(rng, 2, 4) << " ore. Each clay robot costs "
+           << uniform(rng, 2, 4) << " ore. Each obsidian robot costs "
+           << uniform(rng, 2, 4) << " ore and " << uniform(rng, 5, 20)
+           << " clay. Each geode robot costs " << uniform(rng, 2, 4)
+           << " ore and " << uniform(rng, 5, 20) << " obsidian.\n";
+    }
+}
+
+// encrypted file: random numbers with exactly one zero
+void day20(std::ostream &os, double scale, Rng &rng) {
+    const long count = scaled(scale, 5000, 3);
+    const long zero_index = uniform(rng, 0, count - 1);
+    for (long i = 0; i < count; ++i) {
+        long value = 0;
+        if (i != zero_index) {
+            do {
+                value = uniform(rng, -10000, 10000);
+            } while (value == 0);
+        }
+        os << value << '\n';
+    }
+}
+
+// a random expression tree of monkeys. All the divisions are exact, and humn
+// only sits under additions, subtractions and multiplications, so both parts
+// have integer answers.
+void day21(std::ostream &os, double scale, Rng &rng) {
+    struct Node {
+        long lhs = -1, rhs = -1;
+        char op = 0;
+        long value = 0; // part 1 value
+        bool has_humn = false;
+    };
+    // the tree is built bottom-up from leaves, so all values are known
+    const long num_leaves = scaled(scale, 1000, 4);
+    std::vector<Node> nodes{};
+    std::vector<long> roots{};
+    const long humn = 0;
+    nodes.push_back({-1, -1, 0, uniform(rng, 1, 9), true});
+    roots.push_back(humn);
+    for (long i = 1; i < num_leaves; ++i) {
+        nodes.push_back({-1, -1, 0, uniform(rng, 1, 9), false});
+        roots.push_back(i);
+    }
+    constexpr long limit = 1'000'000'000'000L;
+    while (roots.size() > 2) {
+        // combine two random subtrees
+        std::size_t ia = uniform(rng, 0, roots.size() - 1);
+        std::swap(roots[ia], roots.back());
+        long a = roots.back();
+        roots.pop_back();
+        std::size_t ib = uniform(rng, 0, roots.size() - 1);
+        std::swap(roots[ib], roots.back());
+        long b = roots.back();
+        roots.pop_back();
+        if (chance(rng, 0.5)) {
+            std::swap(a, b);
+        }
+        const long va = nodes[a].value, vb = nodes[b].value;
+        const bool has_humn = nodes[a].has_humn || nodes[b].has_humn;
+        Node node{a, b, '+', va + vb, has_humn};
+        long r = uniform(rng, 0, 9);
+        if (r < 2 && std::abs(va) * std::abs(vb) < limit && va != 0 &&
+            vb != 0) {
+            node.op = '*';
+            node.value = va * vb;
+        } else if (r < 4 && !has_humn && vb != 0 && va % vb == 0) {
+            node.op = '/';
+            node.value = va / vb;
+        } else if (r < 7 || std::abs(va + vb) >= limit) {
+            node.op = '-';
+            node.value = va - vb;
+        }
+        nodes.push_back(node);
+        roots.push_back(nodes.size() - 1);
+    }
+    // pick the answer to part 2, and add a constant to the other side of
+    // root so that the two sides are equal for that value of humn
+    const long humn_answer = nodes[humn].value + uniform(rng, 1, 9);
+    std::vector<long> humn_values(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const Node &node = nodes[i];
+        if (node.lhs < 0) {
+            humn_values[i] = i == humn ? humn_answer : node.value;
+            continue;
+        }
+        const long va = humn_values[node.lhs], vb = humn_values[node.rhs];
+        switch (node.op) {
+        case '+':
+            humn_values[i] = va + vb;
+            break;
+        case '-':
+            humn_values[i] = va - vb;
+            break;
+        case '*':
+            humn_values[i] = va * vb;
+            break;
+        case '/':
+            humn_values[i] = va / vb;
+            break;
+        }
+    }
+    long lhs = roots[0], rhs = roots[1];
+    if (!nodes[lhs].has_humn) {
+        std::swap(lhs, rhs);
+    }
+    const long offset = humn_values[lhs] - nodes[rhs].value;
+    nodes.push_back({-1, -1, 0, offset, false});
+    nodes.push_back({rhs, static_cast<long>(nodes.size()) - 1, '+',
+                     nodes[rhs].value + offset, false});
+    rhs = nodes.size() - 1;
+    // the operation is replaced with = in part 2
+    nodes.push_back({lhs, rhs, '+', nodes[lhs].value + nodes[rhs].value, true});
+
+    const int name_length = nodes.size() + 2 < 26 * 26 * 26 * 26 ? 4 : 5;
+    std::vector<long> order(nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    // names are a random permutation, skipping the two reserved ones
+    std::vector<std::string> names(nodes.size());
+    {
+        std::vector<long> ids(nodes.size() + 2);
+        std::iota(ids.begin(), ids.end(), 0);
+        std::shuffle(ids.begin(), ids.end(), rng);
+        std::size_t next = 0;
+        for (std::string &name : names) {
+            do {
+                name = name_for(ids[next++], name_length);
+            } while (name == "humn" || name == "root");
+        }
+    }
+    names[humn] = "humn";
+    names.back() = "root";
+    std::shuffle(order.begin(), order.end(), rng);
+    for (long i : order) {
+        const Node &node = nodes[i];
+        os << names[i] << ": ";
+        if (node.lhs < 0) {
+            os << node.value << '\n';
+        } else {
+            os << names[node.lhs] << ' ' << node.op << ' ' << names[node.rhs]
+               << '\n';
+        }
+    }
+}
+
+// cube net in the same layout as the real input, with random walls and a
+// random path
+void day22(std::ostream &os, double scale, Rng &rng) {
+    const int w = scaled_side(scale, 50, 2);
+    // face positions in units of w
+    constexpr std::array<std::array<bool, 3>, 4> layout{{
+        {false, true, true},
+        {false, true, false},
+        {true, true, false},
+        {true, false, false},
+    }};
+    bool first = true;
+    for (const auto &face_row : layout) {
+        for (int y = 0; y < w; ++y) {
+            std::string line{};
+            for (bool has_face : face_row) {
+                for (int x = 0; x < w; ++x) {
+                    if (!has_face) {
+                        line += ' ';
+                    } else if (first) {
+                        // the starting tile must be open
+                        line += '.';
+                        first = false;
+                    } else {
+                        line += chance(rng, 0.05) ? '#' : '.';
+                    }
+                }
+            }
+            line.erase(line.find_last_not_of(' ') + 1);
+            os << line << '\n';
+        }
+    }
+    os << '\n';
+    for (long i = scaled(scale, 2000); i > 0; --i) {
+        os << uniform(rng, 1, 50);
+        if (i > 1) {
+            os << (chance(rng, 0.5) ? 'L' : 'R');
+        }
+    }
+    os << '\n';
+}
+
+// elves scattered over a square
+void day23(std::ostream &os, double scale, Rng &rng) {
+    const int side = scaled_side(scale, 73, 2);
+    for (int y = 0; y < side; ++y) {
+        std::string row(side, '.');
+        for (char &c : row) {
+            if (chance(rng, 0.5)) {
+                c = '#';
+            }
+        }
+        os << row << '\n';
+    }
+}
+
+// blizzard valley; like the real inputs, there are no vertical blizzards in
+// the entrance and exit columns
+void day24(std::ostream &os, double scale, Rng &rng) {
+    const int width = scaled_side(scale, 120, 3);
+    const int height = scaled_side(scale, 25, 3);
+    os << "#." << std::string(width, '#') << '\n';
+    for (int y = 0; y < height; ++y) {
+        std::string row(width, '.');
+        for (int x = 0; x < width; ++x) {
+            if (!chance(rng, 0.75)) {
+                continue;
+            }
+            const bool vertical_ok = x != 0 && x != width - 1;
+            row[x] = vertical_ok ? "<>^v"[uniform(rng, 0, 3)]
+                                 : "<>"[uniform(rng, 0, 1)];
+        }
+        os << '#' << row << "#\n";
+    }
+    os << std::string(width, '#') << ".#\n";
+}
+
+std::string to_snafu(long value) {
+    std::string digits{};
+    while (value != 0) {
+        long digit = value % 5;
+        value /= 5;
+        if (digit > 2) {
+            digit -= 5;
+            ++value;
+        }
+        digits += "=-012"[digit + 2];
+    }
+    return {digits.rbegin(), digits.rend()};
+}
+
+// SNAFU numbers (small enough that the sum fits in a long)
+void day25(std::ostream &os, double scale, Rng &rng) {
+    for (long i = scaled(scale, 120); i > 0; --i) {
+        os << to_snafu(uniform(rng, 1, 1'000'000'000'000L)) << '\n';
+    }
+}
+
+using generator_func = void (*)(std::ostream &, double, Rng &);
+constexpr std::array<generator_func, 25> generators{
+    day1,  day2,  day3,  day4,  day5,  day6,  day7,  day8,  day9,
+    day10, day11, day12, day13, day14, day15, day16, day17, day18,
+    day19, day20, day21, day22, day23, day24, day25,
+};
+
+} // namespace aoc::gen
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " <day> [scale] [seed]\n"
+                  << "Writes an input for the given day to stdout, at `scale` "
+                     "times the size of\nthe real input (default 1).\n";
+        return 1;
+    }
+    int day = aoc::parse_day(argv[1]);
+    if (day == 0) {
+        std::cerr << "Error: invalid day '" << argv[1] << "'\n";
+        return 1;
+    }
+    double scale = argc > 2 ? std::stod(argv[2]) : 1.0;
+    aoc::gen::Rng rng{argc > 3 ? std::stoul(argv[3]) : 2022};
+    std::ios::sync_with_stdio(false);
+    aoc::gen::generators[day - 1](std::cout, scale, rng);
+    return 0;
+}
@@ -0,0 +1,293 @@
+/******************************************************************************
+ * File:        grid_search.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Compares aoc::GraphSearch and aoc::FrontierSearch with the
+ *              hand-rolled searches they replaced, on 4096x4096 grids: a
+ *              multi-source BFS, Dijkstra with per-cell weights, and a day 24
+ *              style search where the walls change every step.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <array>    // for array
+#include <chrono>   // for steady_clock, duration
+#include <cstddef>  // for size_t, ptrdiff_t
+#include <cstdint>  // for uint64_t
+#include <iomanip>  // for setw, setprecision
+#include <iostream> // for cout, fixed
+#include <queue>    // for queue, priority_queue
+#include <random>   // for mt19937, bernoulli_distribution, ...
+#include <utility>  // for pair, swap
+#include <vector>   // for vector
+
+namespace aoc::bench {
+
+constexpr int SIZE = 4096;
+constexpr std::array<Delta, 4> orthogonal{Delta(1, 0), Delta(-1, 0),
+                                          Delta(0, 1), Delta(0, -1)};
+
+// measures the time since construction, excluding the board setup
+class Stopwatch {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+  public:
+    double elapsed() const {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+};
+
+// the number of cells reached, and the sum of their distances
+struct Result {
+    long reached = 0;
+    long total_distance = 0;
+
+    void add(int distance) {
+        ++reached;
+        total_distance += distance;
+    }
+    bool operator==(const Result &) const = default;
+};
+
+// 1 for open cells, 0 for walls (and the halo)
+Grid<int> random_walls(double density, unsigned seed) {
+    Grid<int> open(SIZE, SIZE, 0, 1);
+    std::mt19937 rng{seed};
+    std::bernoulli_distribution dist{density};
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            open[{x, y}] = !dist(rng);
+        }
+    }
+    return open;
+}
+
+const std::array<Pos, 4> corners{Pos(0, 0), Pos(SIZE - 1, 0),
+                                 Pos(0, SIZE - 1), Pos(SIZE - 1, SIZE - 1)};
+
+Result bfs_queue(const Grid<int> &open, double &seconds) {
+    Stopwatch timer;
+    Grid<int> distances(SIZE, SIZE, -1);
+    std::queue<Pos> queue{};
+    for (const Pos &pos : corners) {
+        distances[pos] = 0;
+        queue.push(pos);
+    }
+    Result result;
+    while (!queue.empty()) {
+        Pos pos = queue.front();
+        queue.pop();
+        result.add(distances[pos]);
+        for (const Delta &delta : orthogonal) {
+            Pos next = pos + delta;
+            if (open[next] && distances[next] < 0) {
+                distances[next] = distances[pos] + 1;
+                queue.push(next);
+            }
+        }
+    }
+    seconds = timer.elapsed();
+    return result;
+}
+
+std::array<std::ptrdiff_t, 4> index_offsets(const Grid<int> &grid) {
+    std::array<std::ptrdiff_t, 4> offsets;
+    for (std::size_t i = 0; i < orthogonal.size(); ++i) {
+        offsets[i] = grid.index_offset(orthogonal[i]);
+    }
+    return offsets;
+}
+
+Result bfs_engine(const Grid<int> &open, GraphSearch &search,
+                  double &seconds) {
+    const auto offsets = index_offsets(open);
+    std::vector<std::size_t> sources{};
+    for (const Pos &pos : corners) {
+        sources.push_back(open.index_of(pos));
+    }
+    Result result;
+    Stopwatch timer;
+    search.bfs(
+        open.num_indices(), sources,
+        [&](std::size_t node, auto push) {
+            for (std::ptrdiff_t offset : offsets) {
+                if (open.cell(node + offset)) {
+                    push(node + offset);
+                }
+            }
+        },
+        [&](std::size_t, int distance) {
+            result.add(distance);
+            return false;
+        });
+    seconds = timer.elapsed();
+    return result;
+}
+
+// 1 to 9 to enter each cell, like 2021 day 15
+Grid<int> random_weights(unsigned seed) {
+    Grid<int> weights(SIZE, SIZE, 0, 1);
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution dist{1, 9};
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            weights[{x, y}] = dist(rng);
+        }
+    }
+    return weights;
+}
+
+Result dijkstra_queue(const Grid<int> &weights, double &seconds) {
+    Stopwatch timer;
+    Grid<int> distances(SIZE, SIZE, -1);
+    using Entry = std::pair<int, Pos>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue{};
+    distances[{0, 0}] = 0;
+    queue.emplace(0, Pos(0, 0));
+    Result result;
+    while (!queue.empty()) {
+        auto [distance, pos] = queue.top();
+        queue.pop();
+        if (distance > distances[pos]) {
+            continue;
+        }
+        result.add(distance);
+        for (const Delta &delta : orthogonal) {
+            Pos next = pos + delta;
+            if (!distances.in_bounds(next)) {
+                continue;
+            }
+            int next_distance = distance + weights[next];
+            if (distances[next] < 0 || next_distance < distances[next]) {
+                distances[next] = next_distance;
+                queue.emplace(next_distance, next);
+            }
+        }
+    }
+    seconds = timer.elapsed();
+    return result;
+}
+
+Result dijkstra_engine(const Grid<int> &weights, GraphSearch &search,
+                       double &seconds) {
+    const auto offsets = index_offsets(weights);
+    Result result;
+    Stopwatch timer;
+    search.dijkstra(
+        weights.num_indices(), {weights.index_of(Pos(0, 0))},
+        [&](std::size_t node, auto push) {
+            for (std::ptrdiff_t offset : offsets) {
+                // the halo has weight 0
+                if (int weight = weights.cell(node + offset)) {
+                    push(node + offset, weight);
+                }
+            }
+        },
+        [&](std::size_t, int distance) {
+            result.add(distance);
+            return false;
+        });
+    seconds = timer.elapsed();
+    return result;
+}
+
+// Two sets of walls that alternate every step, starting from the center:
+// result.reached is the final frontier size.
+constexpr int LAYERS = 256;
+
+Result layered_set(const std::array<Grid<int>, 2> &open, double &seconds) {
+    Stopwatch timer;
+    PosSet curr{Pos(SIZE / 2, SIZE / 2)}, next{};
+    for (int layer = 1; layer <= LAYERS; ++layer) {
+        const Grid<int> &walls = open[layer % 2];
+        for (const Pos &pos : curr) {
+            if (walls[pos]) {
+                next.insert(pos);
+            }
+            for (const Delta &delta : orthogonal) {
+                if (walls[pos + delta]) {
+                    next.insert(pos + delta);
+                }
+            }
+        }
+        curr.clear();
+        std::swap(curr, next);
+    }
+    seconds = timer.elapsed();
+    return {static_cast<long>(curr.size()), 0};
+}
+
+Result layered_engine(const std::array<Grid<int>, 2> &open, double &seconds) {
+    std::array<BitGrid, 2> masks{BitGrid(SIZE, SIZE), BitGrid(SIZE, SIZE)};
+    for (int i = 0; i < 2; ++i) {
+        for (int y = 0; y < SIZE; ++y) {
+            for (int x = 0; x < SIZE; ++x) {
+                masks[i].set({x, y}, open[i][{x, y}]);
+            }
+        }
+    }
+    constexpr std::array<Delta, 5> moves{Delta(0, 0), Delta(1, 0),
+                                         Delta(-1, 0), Delta(0, 1),
+                                         Delta(0, -1)};
+    FrontierSearch search;
+    BitGrid frontier(SIZE, SIZE);
+    frontier.set(Pos(SIZE / 2, SIZE / 2));
+    Stopwatch timer;
+    search.run(
+        frontier, moves,
+        [&](int layer) -> const BitGrid & { return masks[layer % 2]; },
+        [](const BitGrid &, int layer) { return layer == LAYERS; });
+    seconds = timer.elapsed();
+    return {frontier.count(), 0};
+}
+
+void report(const char *name, double baseline_time, double engine_time,
+            const Result &baseline, const Result &engine) {
+    std::cout << std::left << std::setw(16) << name << std::right
+              << std::fixed << std::setprecision(4) << std::setw(10)
+              << baseline_time << std::setw(10) << engine_time
+              << std::setprecision(1) << std::setw(8)
+              << baseline_time / engine_time << "x";
+    if (baseline != engine) {
+        std::cout << "  MISMATCH: " << baseline.reached << "/"
+                  << baseline.total_distance << " != " << engine.reached << "/"
+                  << engine.total_distance;
+    }
+    std::cout << "\n";
+}
+
+} // namespace aoc::bench
+
+int main() {
+    using namespace aoc::bench;
+    std::cout << "workload          baseline    engine speedup\n";
+    double baseline_time, engine_time;
+    aoc::GraphSearch search;
+
+    {
+        const auto open = random_walls(0.3, 17);
+        Result baseline = bfs_queue(open, baseline_time);
+        Result engine = bfs_engine(open, search, engine_time);
+        report("bfs", baseline_time, engine_time, baseline, engine);
+        // the second search reuses the buffers from the first
+        engine = bfs_engine(open, search, engine_time);
+        report("bfs (reused)", baseline_time, engine_time, baseline, engine);
+    }
+    {
+        const auto weights = random_weights(15);
+        Result baseline = dijkstra_queue(weights, baseline_time);
+        Result engine = dijkstra_engine(weights, search, engine_time);
+        report("dijkstra", baseline_time, engine_time, baseline, engine);
+    }
+    {
+        const std::array<aoc::Grid<int>, 2> open{random_walls(0.3, 24),
+                                                 random_walls(0.3, 25)};
+        Result baseline = layered_set(open, baseline_time);
+        Result engine = layered_engine(open, engine_time);
+        report("layered bitset", baseline_time, engine_time, baseline, engine);
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * File:        pos_set.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Compares aoc::PosSet with std::set<Pos> on the day 9 (rope
+ *              positions) and day 24 (BFS frontier) access patterns, at 1x,
+ *              10x and 100x the size of the real inputs.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <array>    // for array
+#include <chrono>   // for steady_clock, duration
+#include <cstdlib>  // for abs
+#include <iomanip>  // for setw, setprecision
+#include <iostream> // for cout, fixed
+#include <random>   // for mt19937, uniform_int_distribution
+#include <set>      // for set
+#include <utility>  // for swap
+
+namespace aoc::bench {
+
+void move_tail(const Pos &head, Pos &tail) {
+    Delta delta = head - tail;
+    if (delta.chebyshev_distance() <= 1) {
+        return;
+    }
+    if (std::abs(delta.dx) == 2) {
+        delta.dx /= 2;
+    }
+    if (std::abs(delta.dy) == 2) {
+        delta.dy /= 2;
+    }
+    tail += delta;
+}
+
+// day 9: the real input has 2000 moves
+template <typename Set>
+std::size_t rope_walk(int scale) {
+    std::mt19937 rng{9};
+    std::uniform_int_distribution<int> dir_dist{0, 3}, count_dist{1, 20};
+    constexpr std::array<Direction, 4> dirs{Direction::up, Direction::down,
+                                            Direction::left, Direction::right};
+    std::array<Pos, 10> rope{};
+    Set second_knot{rope[1]};
+    Set tail{rope.back()};
+    for (int i = 0; i < 2000 * scale; ++i) {
+        Delta delta{dirs[dir_dist(rng)]};
+        for (int count = count_dist(rng); count > 0; --count) {
+            rope[0] += delta;
+            for (std::size_t k = 1; k < rope.size(); ++k) {
+                move_tail(rope[k - 1], rope[k]);
+            }
+            second_knot.insert(rope[1]);
+            tail.insert(rope.back());
+        }
+    }
+    return second_knot.size() + tail.size();
+}
+
+// day 24: the real valley is 120x25, and the search runs for ~900 minutes
+template <typename Set>
+std::size_t frontier(int scale) {
+    const int width = 120 * scale, height = 25;
+    std::mt19937 rng{24};
+    std::bernoulli_distribution blocked{0.3};
+    Set curr{Pos(0, 0)};
+    Set next{};
+    std::size_t total = 0;
+    for (int minute = 0; minute < 900; ++minute) {
+        for (const Pos &pos : curr) {
+            for (Delta delta : {Delta(0, 0), Delta(1, 0), Delta(-1, 0),
+                                Delta(0, 1), Delta(0, -1)}) {
+                Pos candidate = pos + delta;
+                if (candidate.x < 0 || candidate.x >= width ||
+                    candidate.y < 0 || candidate.y >= height ||
+                    blocked(rng)) {
+                    continue;
+                }
+                next.insert(candidate);
+            }
+        }
+        if (next.empty()) {
+            next.insert(Pos(0, 0));
+        }
+        total += next.size();
+        curr.clear();
+        std::swap(curr, next);
+    }
+    return total;
+}
+
+template <typename Func>
+double time_it(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    volatile std::size_t result = func();
+    static_cast<void>(result);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char *name, int scale, double set_time, double flat_time) {
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::setw(6) << scale << std::fixed << std::setprecision(4)
+              << std::setw(11) << set_time << std::setw(9) << flat_time
+              << std::setprecision(2) << std::setw(8)
+              << set_time / flat_time << "x\n";
+}
+
+} // namespace aoc::bench
+
+int main() {
+    using namespace aoc::bench;
+    using aoc::Pos;
+    using aoc::PosSet;
+    std::cout << "workload   scale   std::set   PosSet  speedup\n";
+    for (int scale : {1, 10, 100}) {
+        report("rope_walk", scale,
+               time_it([=] { return rope_walk<std::set<Pos>>(scale); }),
+               time_it([=] { return rope_walk<PosSet>(scale); }));
+    }
+    for (int scale : {1, 10, 100}) {
+        report("frontier", scale,
+               time_it([=] { return frontier<std::set<Pos>>(scale); }),
+               time_it([=] { return frontier<PosSet>(scale); }));
+    }
+    return 0;
+}
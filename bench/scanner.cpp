@@ -0,0 +1,109 @@
+/******************************************************************************
+ * File:        scanner.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Compares aoc::Scanner with the istream manipulators (skip() and
+ *              as_number) on a large synthetic day 19 blueprint file.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <chrono>   // for steady_clock, duration
+#include <cstdio>   // for remove
+#include <cstdlib>  // for stol
+#include <fstream>  // for ofstream
+#include <iostream> // for cout, cerr
+#include <random>   // for mt19937, uniform_int_distribution
+#include <string>   // for string
+
+namespace aoc::bench {
+
+struct Blueprint {
+    int id = -1;
+    unsigned char costs[6]{};
+};
+
+std::istream &operator>>(std::istream &is, Blueprint &bp) {
+    if (!(is >> skip(1))) {
+        return is;
+    }
+    is >> bp.id >> skip(1);
+    is >> skip(4) >> as_number{bp.costs[0]} >> skip(1);
+    is >> skip(4) >> as_number{bp.costs[1]} >> skip(1);
+    is >> skip(4) >> as_number{bp.costs[2]} >> skip(2) >>
+        as_number{bp.costs[3]} >> skip(1);
+    is >> skip(4) >> as_number{bp.costs[4]} >> skip(2) >>
+        as_number{bp.costs[5]} >> skip(1);
+    return is;
+}
+
+Scanner &operator>>(Scanner &scan, Blueprint &bp) {
+    if (!scan.skip_tokens(1)) {
+        return scan;
+    }
+    bp.id = scan.next_int();
+    scan.skip_tokens(1);
+    bp.costs[0] = scan.skip_tokens(4).next_int<unsigned char>();
+    scan.skip_tokens(1);
+    bp.costs[1] = scan.skip_tokens(4).next_int<unsigned char>();
+    scan.skip_tokens(1);
+    bp.costs[2] = scan.skip_tokens(4).next_int<unsigned char>();
+    bp.costs[3] = scan.skip_tokens(2).next_int<unsigned char>();
+    scan.skip_tokens(1);
+    bp.costs[4] = scan.skip_tokens(4).next_int<unsigned char>();
+    bp.costs[5] = scan.skip_tokens(2).next_int<unsigned char>();
+    scan.skip_tokens(1);
+    return scan;
+}
+
+void write_blueprints(const std::string &filename, long target_bytes) {
+    std::mt19937 rng{19};
+    std::uniform_int_distribution<int> small{2, 4}, large{5, 20};
+    std::ofstream os{filename};
+    for (int id = 1; os.tellp() < target_bytes; ++id) {
+        os << "Blueprint " << id << ": Each ore robot costs " << small(rng)
+           << " ore. Each clay robot costs " << small(rng)
+           << " ore. Each obsidian robot costs " << small(rng) << " ore and "
+           << large(rng) << " clay. Each geode robot costs " << small(rng)
+           << " ore and " << large(rng) << " obsidian.\n";
+    }
+}
+
+template <typename Reader>
+double time_parse(const char *name, Reader &reader) {
+    auto start = std::chrono::steady_clock::now();
+    Blueprint bp;
+    long count = 0, checksum = 0;
+    while (reader >> bp) {
+        ++count;
+        for (unsigned char cost : bp.costs) {
+            checksum += cost;
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << count << " blueprints (checksum " << checksum
+              << ") in " << elapsed.count() << " s\n";
+    return elapsed.count();
+}
+
+} // namespace aoc::bench
+
+int main(int argc, char **argv) {
+    using namespace aoc::bench;
+    // size in MB
+    long size = argc > 1 ? std::stol(argv[1]) : 100;
+    std::string filename = "/tmp/aoc_bench_blueprints.txt";
+    std::cerr << "writing " << size << " MB of blueprints to " << filename
+              << "...\n";
+    write_blueprints(filename, size * 1000 * 1000);
+
+    aoc::MappedInput input{filename};
+    double stream_time = time_parse("istream", input.stream());
+    aoc::Scanner scan{input.view()};
+    double scan_time = time_parse("Scanner", scan);
+    std::cout << "speedup: " << stream_time / scan_time << "x\n";
+
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * File:        thread_pool.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Scaling of aoc::ThreadPool from 1 to N threads, on a
+ *              coarse-grained reduction, lots of tiny tasks, and nested task
+ *              groups. Also checks that every thread count gets the same
+ *              result.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <algorithm> // for max
+#include <chrono>    // for steady_clock, duration
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <iomanip>   // for setw, setprecision
+#include <iostream>  // for cout, cerr, fixed
+#include <string>    // for stoi
+#include <thread>    // for hardware_concurrency
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+namespace aoc::bench {
+
+std::uint64_t collatz_steps(std::uint64_t n) {
+    std::uint64_t steps = 0;
+    while (n != 1) {
+        n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+        ++steps;
+    }
+    return steps;
+}
+
+// a few large chunks: should scale almost linearly
+std::uint64_t coarse(ThreadPool &pool) {
+    return parallel_reduce(
+        1, 4'000'000, std::uint64_t{0}, collatz_steps,
+        [](std::uint64_t a, std::uint64_t b) { return a + b; }, 16384, pool);
+}
+
+// one task per index: mostly measures the pool's overhead
+std::uint64_t fine(ThreadPool &pool) {
+    std::vector<std::uint64_t> results(200'000);
+    parallel_for(
+        0, results.size(),
+        [&](std::size_t i) { results[i] = collatz_steps(i + 1); }, 1, pool);
+    std::uint64_t total = 0;
+    for (std::uint64_t steps : results) {
+        total += steps;
+    }
+    return total;
+}
+
+// reductions inside a parallel loop, so waiting threads have to help
+std::uint64_t nested(ThreadPool &pool) {
+    return parallel_reduce(
+        0, 64, std::uint64_t{0},
+        [&](std::size_t outer) {
+            return parallel_reduce(
+                outer * 50'000 + 1, (outer + 1) * 50'000 + 1,
+                std::uint64_t{0}, collatz_steps,
+                [](std::uint64_t a, std::uint64_t b) { return a + b; }, 2048,
+                pool);
+        },
+        [](std::uint64_t a, std::uint64_t b) { return a + b; }, 1, pool);
+}
+
+using Workload = std::uint64_t (*)(ThreadPool &pool);
+
+template <typename Func>
+double time_it(Func func, std::uint64_t &result) {
+    auto start = std::chrono::steady_clock::now();
+    result = func();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace aoc::bench
+
+int main(int argc, char **argv) {
+    using namespace aoc::bench;
+    const unsigned max_threads =
+        argc > 1 ? std::stoi(argv[1])
+                 : std::max(std::thread::hardware_concurrency(), 1u);
+    // powers of 2, and then max_threads
+    std::vector<unsigned> thread_counts{};
+    for (unsigned threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    int exit_code = 0;
+    std::cout << "workload  threads   time (s)  speedup\n";
+    for (auto [name, workload] : {std::pair<const char *, Workload>{
+                                      "coarse", coarse},
+                                  {"fine", fine},
+                                  {"nested", nested}}) {
+        double serial_time = 0;
+        std::uint64_t serial_result = 0;
+        for (unsigned threads : thread_counts) {
+            aoc::ThreadPool pool{threads};
+            std::uint64_t result;
+            const double elapsed =
+                time_it([&] { return workload(pool); }, result);
+            if (threads == 1) {
+                serial_time = elapsed;
+                serial_result = result;
+            } else if (result != serial_result) {
+                std::cerr << "ERROR: " << name << " got " << result << " with "
+                          << threads << " threads, but " << serial_result
+                          << " with 1\n";
+                exit_code = 1;
+            }
+            std::cout << std::left << std::setw(8) << name << std::right
+                      << std::setw(9) << threads << std::fixed
+                      << std::setprecision(4) << std::setw(11) << elapsed
+                      << std::setprecision(2) << std::setw(8)
+                      << serial_time / elapsed << "x\n";
+        }
+    }
+    return exit_code;
+}
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * File:        valve_parse.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Compares the old regex-based day 16 valve parser (with a
+ *              std::map name lookup) against aoc::Scanner and a direct
+ *              two-letter name table, on a large synthetic valve file.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <array>    // for array
+#include <chrono>   // for steady_clock, duration
+#include <cstdio>   // for remove
+#include <fstream>  // for ofstream
+#include <iostream> // for cout, cerr
+#include <map>      // for map
+#include <random>   // for mt19937, uniform_int_distribution
+#include <regex>    // for regex, smatch, regex_search, sregex_iterator
+#include <string>   // for string, getline, stoi, stol, to_string
+#include <unistd.h> // for getpid
+
+namespace aoc::bench {
+
+// the totals each parser reports, so they can be checked against each other
+struct ParseResult {
+    long lines = 0;
+    long tunnels = 0;
+    long checksum = 0;
+
+    bool operator==(const ParseResult &) const = default;
+};
+
+ParseResult parse_regex(std::istream &is) {
+    static std::regex number_regex{"\\d+"};
+    static std::regex valve_regex{"[A-Z]{2}"};
+    std::map<std::string, int> name_lookup;
+    auto intern = [&name_lookup](const std::string &name) {
+        return name_lookup.emplace(name, name_lookup.size()).first->second;
+    };
+
+    ParseResult result;
+    std::string line;
+    while (std::getline(is, line)) {
+        std::smatch number_match;
+        std::regex_search(line, number_match, number_regex);
+        int flow_rate = std::stoi(number_match[0]);
+        auto valve_iter =
+            std::sregex_iterator(line.cbegin(), line.cend(), valve_regex);
+        auto valves_end = std::sregex_iterator();
+        int key = intern(valve_iter->str());
+        ++valve_iter;
+        ++result.lines;
+        result.checksum += key * flow_rate;
+        for (; valve_iter != valves_end; ++valve_iter) {
+            ++result.tunnels;
+            result.checksum += intern(valve_iter->str());
+        }
+    }
+    return result;
+}
+
+ParseResult parse_table(std::string_view text) {
+    std::array<int, 26 * 26> name_lookup;
+    name_lookup.fill(-1);
+    int num_names = 0;
+    auto intern = [&](std::string_view name) {
+        int &key = name_lookup[(name[0] - 'A') * 26 + (name[1] - 'A')];
+        if (key == -1) {
+            key = num_names++;
+        }
+        return key;
+    };
+
+    ParseResult result;
+    for (std::string_view line : lines(text)) {
+        Scanner scan{line};
+        int key = intern(scan.skip_tokens(1).next_token());
+        int flow_rate = scan.skip_until('=').next_int();
+        scan.skip_until(';').skip_tokens(4);
+        ++result.lines;
+        result.checksum += key * flow_rate;
+        while (!scan.at_end()) {
+            std::string_view name = scan.next_token();
+            if (name.ends_with(',')) {
+                name.remove_suffix(1);
+            }
+            ++result.tunnels;
+            result.checksum += intern(name);
+        }
+    }
+    return result;
+}
+
+// every name from AA to ZZ shows up, in a random order, so both lookups end
+// up holding all 676 entries
+void write_valves(const std::string &filename, long target_bytes) {
+    std::mt19937 rng{16};
+    std::uniform_int_distribution<int> name_dist{0, 26 * 26 - 1};
+    std::uniform_int_distribution<int> flow_dist{0, 25}, tunnel_dist{1, 5};
+    auto name = [](int index) {
+        return std::string{char('A' + index / 26), char('A' + index % 26)};
+    };
+    std::ofstream os{filename};
+    while (os.tellp() < target_bytes) {
+        os << "Valve " << name(name_dist(rng)) << " has flow rate="
+           << flow_dist(rng) << "; ";
+        int num_tunnels = tunnel_dist(rng);
+        if (num_tunnels == 1) {
+            os << "tunnel leads to valve " << name(name_dist(rng)) << "\n";
+            continue;
+        }
+        os << "tunnels lead to valves ";
+        for (int i = 0; i < num_tunnels; ++i) {
+            os << (i > 0 ? ", " : "") << name(name_dist(rng));
+        }
+        os << "\n";
+    }
+}
+
+template <typename Parser>
+double time_parse(const char *name, Parser parser, ParseResult &result) {
+    auto start = std::chrono::steady_clock::now();
+    result = parser();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << result.lines << " valves, " << result.tunnels
+              << " tunnels (checksum " << result.checksum << ") in "
+              << elapsed.count() << " s\n";
+    return elapsed.count();
+}
+
+} // namespace aoc::bench
+
+int main(int argc, char **argv) {
+    using namespace aoc::bench;
+    // size in MB
+    long size = argc > 1 ? std::stol(argv[1]) : 10;
+    // unique per run, so concurrent runs don't clobber each other's file
+    std::string filename =
+        "/tmp/aoc_bench_valves." + std::to_string(getpid()) + ".txt";
+    std::cerr << "writing " << size << " MB of valves to " << filename
+              << "...\n";
+    write_valves(filename, size * 1000 * 1000);
+
+    ParseResult regex_result, table_result;
+    double regex_time, table_time;
+    {
+        aoc::MappedInput input{filename};
+        regex_time = time_parse(
+            "regex", [&] { return parse_regex(input.stream()); },
+            regex_result);
+        table_time = time_parse(
+            "table", [&] { return parse_table(input.view()); }, table_result);
+    }
+    std::remove(filename.c_str());
+
+    std::cout << "speedup: " << regex_time / table_time << "x\n";
+    if (regex_result != table_result) {
+        std::cout << "MISMATCH: the parsers disagree\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#!/bin/bash
+set -euo pipefail
+
+usage() {
+  echo "Usage: day16_engines.sh [-v <valve counts>] [-n <runs>] [-b <time budget>]"
+}
+
+# cd to directory of this script (repository root)
+cd -- "$(dirname -- "${BASH_SOURCE[0]}")"
+source ./lib.sh
+
+valve_counts=$(seq -s ' ' 15 24)
+runs=3
+# give up on an engine once a single run takes longer than this many seconds
+budget=60
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    -v|--valves)
+      valve_counts=$2
+      shift
+      shift
+      ;;
+    -n|--runs)
+      runs=$2
+      shift
+      shift
+      ;;
+    -b|--budget)
+      budget=$2
+      shift
+      shift
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    *)
+      echo "Error: unrecognized option '$1'"
+      usage
+      exit 1
+      ;;
+  esac
+done
+
+make_quiet build/bench/gen_input
+make_quiet build/fast/aoc_bench
+make_quiet build/fast/day16
+
+input_dir=build/scaling
+mkdir -p "$input_dir"
+json_file=$(mktemp)
+trap 'rm -f "$json_file"' EXIT
+
+engines=(search subsets)
+printf '%6s' valves
+printf '%14s' "${engines[@]/%/ (ms)}"
+printf '%10s\n' speedup
+for valves in $valve_counts; do
+  input_file=$input_dir/day16-v$valves.txt
+  if ! [[ -e $input_file ]]; then
+    AOC_GEN_FLOW_VALVES=$valves build/bench/gen_input 16 > "$input_file"
+  fi
+  printf '%6d' "$valves"
+  medians=()
+  answers=()
+  for engine in "${engines[@]}"; do
+    if ! answer=$(AOC_DAY16_ENGINE=$engine timeout "$budget" build/fast/day16 "$input_file" 2>/dev/null) ||
+       ! AOC_DAY16_ENGINE=$engine timeout "$((budget * runs))" build/fast/aoc_bench -w 0 -n "$runs" -f "$input_file" -o "$json_file" 16 >/dev/null 2>&1; then
+      printf '%14s' timeout
+      medians+=(-)
+      continue
+    fi
+    median=$(sed -ne 's/.*"total": {"min": [^,]*, "median": \([^,]*\),.*/\1/p' "$json_file")
+    awk -v t="$median" 'BEGIN { printf "%14.3f", t * 1000 }'
+    medians+=("$median")
+    answers+=("$(echo $answer)")
+  done
+  if [[ ${medians[0]} == - || ${medians[1]} == - ]]; then
+    printf '%10s\n' -
+  else
+    awk -v a="${medians[0]}" -v b="${medians[1]}" 'BEGIN { printf "%9.1fx", a / b }'
+    if [[ ${answers[0]} != "${answers[1]}" ]]; then
+      printf '  MISMATCH: %s != %s' "${answers[0]}" "${answers[1]}"
+    fi
+    printf '\n'
+  fi
+done
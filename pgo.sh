@@ -0,0 +1,66 @@
+#!/bin/bash
+set -euo pipefail
+
+usage() {
+  echo "Usage: pgo.sh [-n <runs>] [-e <example number>|-i <input file name>] [day...]"
+}
+
+# cd to directory of this script (repository root)
+cd -- "$(dirname -- "${BASH_SOURCE[0]}")"
+source ./lib.sh
+
+runs=10
+input_args=()
+days=()
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    -n|--runs)
+      runs=$2
+      shift
+      shift
+      ;;
+    -e|--example|-i|--input)
+      input_args=("$1" "$2")
+      shift
+      shift
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    -*)
+      echo "Error: unrecognized option '$1'"
+      usage
+      exit 1
+      ;;
+    *)
+      days+=("${1#0}")
+      shift
+      ;;
+  esac
+done
+
+# the pgo build trains on every stored input the first time, and again
+# whenever a source file or input changes
+make_quiet build/fast/aoc_bench
+make_quiet pgo
+
+fast_json=$(mktemp)
+pgo_json=$(mktemp)
+trap 'rm -f "$fast_json" "$pgo_json"' EXIT
+label=$(git describe --always --dirty)
+build/fast/aoc_bench -n "$runs" "${input_args[@]}" -o "$fast_json" -l "$label fast" "${days[@]}" >/dev/null
+build/pgo/aoc_bench -n "$runs" "${input_args[@]}" -o "$pgo_json" -l "$label pgo" "${days[@]}" >/dev/null
+
+# pull the median total time for each day out of both files, and match them up
+medians() {
+  sed -ne 's/.*"day": \([0-9]*\),.*/\1/p; s/.*"total": {"min": [^,]*, "median": \([^,]*\),.*/\1/p' "$1" | paste - -
+}
+awk '
+  BEGIN { printf "Day%14s%14s%10s\n", "fast (ms)", "pgo (ms)", "speedup" }
+  NR == FNR { fast[$1] = $2; next }
+  $1 in fast {
+    printf "%3d%14.3f%14.3f%9.2fx\n", $1, fast[$1] * 1000, $2 * 1000, fast[$1] / $2
+    log_sum += log(fast[$1] / $2); n++
+  }
+  END { if (n > 0) printf "geometric mean speedup: %.2fx\n", exp(log_sum / n) }' <(medians "$fast_json") <(medians "$pgo_json")
@@ -6,11 +6,15 @@ source ./lib.sh
 
 day=$1
 num=${2:-1}
+runs=${3:-10}
 log_file="profiling/logs/day${day}_${num}.folded"
 svg_file="profiling/day${day}_${num}.svg"
+json_file="profiling/logs/day${day}_${num}.json"
 
 mkdir -p profiling/logs
-make_quiet "build/profile/day$day"
-perf record -g --call-graph dwarf -F 99 hyperfine --shell=none "build/profile/day$day input/day$day/input.txt"
+make_quiet build/profile/aoc_bench
+# run the solution repeatedly in-process, so the profile isn't dominated by
+# startup, and keep the timings alongside the flame graph
+perf record -g --call-graph dwarf -F 99 build/profile/aoc_bench -n "$runs" -o "$json_file" -l "$(git describe --always --dirty)" "${day#0}"
 perf script --header -F comm,pid,tid,time,event,ip,sym,dso | inferno-collapse-perf --skip-after main > "$log_file"
 inferno-flamegraph --inverted --deterministic "$log_file" > "$svg_file"
@@ -0,0 +1,102 @@
+#!/bin/bash
+set -euo pipefail
+
+usage() {
+  echo "Usage: scaling.sh [-s <scales>] [-n <runs>] [-b <time budget>] [day...]"
+}
+
+# cd to directory of this script (repository root)
+cd -- "$(dirname -- "${BASH_SOURCE[0]}")"
+source ./lib.sh
+
+scales="1 10 100 1000"
+runs=3
+# stop scaling up a day once a run takes longer than this many seconds
+budget=10
+days=()
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    -s|--scales)
+      scales=$2
+      shift
+      shift
+      ;;
+    -n|--runs)
+      runs=$2
+      shift
+      shift
+      ;;
+    -b|--budget)
+      budget=$2
+      shift
+      shift
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    -*)
+      echo "Error: unrecognized option '$1'"
+      usage
+      exit 1
+      ;;
+    *)
+      days+=("${1#0}")
+      shift
+      ;;
+  esac
+done
+if [[ ${#days[@]} -eq 0 ]]; then
+  days=($(seq 1 25))
+fi
+
+make_quiet build/bench/gen_input
+make_quiet build/fast/aoc_bench
+
+input_dir=build/scaling
+mkdir -p "$input_dir"
+json_file=$(mktemp)
+trap 'rm -f "$json_file"' EXIT
+
+read -ra scale_list <<< "$scales"
+printf 'Day'
+printf '%12s' "${scale_list[@]/%/x (ms)}"
+printf '%10s%10s\n' exponent last
+for day in "${days[@]}"; do
+  printf '%3d' "$day"
+  points=()
+  stop=n
+  for scale in "${scale_list[@]}"; do
+    if [[ $stop == y ]]; then
+      printf '%12s' -
+      continue
+    fi
+    input_file=$input_dir/day$(printf '%02d' "$day")-x$scale.txt
+    if ! [[ -e $input_file ]]; then
+      build/bench/gen_input "$day" "$scale" > "$input_file"
+    fi
+    if ! build/fast/aoc_bench -w 0 -n "$runs" -f "$input_file" -o "$json_file" "$day" >/dev/null 2>&1; then
+      printf '%12s' failed
+      stop=y
+      continue
+    fi
+    median=$(sed -ne 's/.*"total": {"min": [^,]*, "median": \([^,]*\),.*/\1/p' "$json_file")
+    points+=("$scale $median")
+    awk -v t="$median" 'BEGIN { printf "%12.3f", t * 1000 }'
+    if awk -v t="$median" -v b="$budget" 'BEGIN { exit !(t > b) }'; then
+      stop=y
+    fi
+  done
+  # least-squares fit of log(time) against log(scale) over all the points,
+  # and the slope between the last two
+  printf '%s\n' "${points[@]}" | awk '
+    NF == 2 {
+      x = log($1); y = log($2); n++
+      sx += x; sy += y; sxx += x * x; sxy += x * y
+      px = lx; py = ly; lx = x; ly = y
+    }
+    END {
+      if (n < 2) { printf "%10s%10s\n", "-", "-"; exit }
+      printf "%10.2f%10.2f\n", (n * sxy - sx * sy) / (n * sxx - sx * sx), (ly - py) / (lx - px)
+    }'
+done
@@ -0,0 +1,320 @@
+/******************************************************************************
+ * File:        alloc_hooks.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Replacements for the global operator new and delete, only
+ *              linked into the alloc build. Every allocation is counted
+ *              against the current phase of the running solution and bucketed
+ *              by its call site; see aoc::alloc in lib.h.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <algorithm>   // for sort, min
+#include <array>       // for array
+#include <atomic>      // for atomic_flag
+#include <bit>         // for bit_width
+#include <cstddef>     // for size_t, max_align_t
+#include <cstdint>     // for uintptr_t
+#include <cstdlib>     // for malloc, free
+#include <cxxabi.h>    // for __cxa_demangle
+#include <dlfcn.h>     // for dladdr, Dl_info
+#include <iomanip>     // for setw
+#include <iostream>    // for ostream, left, right, hex
+#include <new>         // for new_handler, get_new_handler, bad_alloc, ...
+#include <sstream>     // for ostringstream
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <vector>      // for vector
+
+namespace aoc::alloc {
+namespace {
+
+enum Phase { OUTSIDE, PARSE, SOLVE, NUM_PHASES };
+
+struct PhaseStats {
+    long allocs = 0;
+    long frees = 0;
+    long bytes = 0;
+    long peak_live = 0;
+};
+
+// allocations from a single return address in operator new
+struct Site {
+    const void *address = nullptr;
+    long allocs = 0;
+    long bytes = 0;
+};
+
+// must be a power of 2
+constexpr std::size_t NUM_SITES = 4096;
+
+// This all has to work before main() and without allocating, so it's a
+// fixed-size, constant-initialized block.
+struct State {
+    std::atomic_flag lock{};
+    Phase phase = OUTSIDE;
+    bool marked = false;
+    long live = 0;
+    long live_at_begin = 0;
+    std::array<PhaseStats, NUM_PHASES> phases{};
+    // open-addressed hash table, keyed on address
+    std::array<Site, NUM_SITES> sites{};
+    long dropped_allocs = 0;
+};
+
+constinit State state{};
+
+class Lock {
+  public:
+    Lock() {
+        while (state.lock.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+    ~Lock() { state.lock.clear(std::memory_order_release); }
+    Lock(const Lock &) = delete;
+    Lock &operator=(const Lock &) = delete;
+};
+
+void record_site(const void *address, std::size_t size) {
+    // Fibonacci hashing: the top bits of the product index the table
+    constexpr int SHIFT = 64 - std::bit_width(NUM_SITES - 1);
+    std::size_t index =
+        (reinterpret_cast<std::uintptr_t>(address) * 0x9E3779B97F4A7C15ull) >>
+        SHIFT;
+    for (std::size_t probes = 0; probes < NUM_SITES; ++probes) {
+        Site &site = state.sites[index];
+        if (site.address == nullptr) {
+            site.address = address;
+        }
+        if (site.address == address) {
+            ++site.allocs;
+            site.bytes += size;
+            return;
+        }
+        index = (index + 1) % NUM_SITES;
+    }
+    ++state.dropped_allocs;
+}
+
+void record_alloc(std::size_t size, const void *site) {
+    Lock lock{};
+    PhaseStats &stats = state.phases[state.phase];
+    ++stats.allocs;
+    stats.bytes += size;
+    state.live += size;
+    stats.peak_live = std::max(stats.peak_live, state.live);
+    if (state.phase != OUTSIDE) {
+        record_site(site, size);
+    }
+}
+
+void record_free(std::size_t size) {
+    Lock lock{};
+    ++state.phases[state.phase].frees;
+    state.live -= size;
+}
+
+void start_phase(Phase phase) {
+    state.phase = phase;
+    state.phases[phase] = {};
+    state.phases[phase].peak_live = state.live;
+}
+
+// Each block gets a header holding the requested size, so operator delete
+// can account for it. This keeps max_align_t alignment for the caller; the
+// over-aligned overloads aren't replaced, and go straight to the library.
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void *allocate(std::size_t size, const void *site) {
+    while (true) {
+        if (void *block = std::malloc(size + HEADER_SIZE)) {
+            *static_cast<std::size_t *>(block) = size;
+            record_alloc(size, site);
+            return static_cast<char *>(block) + HEADER_SIZE;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *allocate_nothrow(std::size_t size, const void *site) noexcept {
+    try {
+        return allocate(size, site);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void deallocate(void *ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    void *block = static_cast<char *>(ptr) - HEADER_SIZE;
+    record_free(*static_cast<std::size_t *>(block));
+    std::free(block);
+}
+
+// Names the function containing an address, using the nearest exported
+// symbol (the alloc build links with -rdynamic so there are some). The offset
+// tells apart different sites in the same function; `addr2line -f -i -e
+// <binary>` can resolve it to a line.
+std::string symbolize(const void *address) {
+    constexpr std::size_t MAX_LENGTH = 100;
+    Dl_info info{};
+    if (dladdr(address, &info) == 0) {
+        std::ostringstream os{};
+        os << address;
+        return os.str();
+    }
+    if (info.dli_sname == nullptr) {
+        // not exported (internal linkage), so give the offset in the binary
+        std::ostringstream os{};
+        os << info.dli_fname << "+0x" << std::hex
+           << static_cast<const char *>(address) -
+                  static_cast<const char *>(info.dli_fbase);
+        return os.str();
+    }
+    int status = 0;
+    char *demangled =
+        abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    std::string name = status == 0 ? demangled : info.dli_sname;
+    std::free(demangled);
+    if (name.size() > MAX_LENGTH) {
+        name.resize(MAX_LENGTH - 3);
+        name += "...";
+    }
+    std::ostringstream os{};
+    os << name << "+0x" << std::hex
+       << static_cast<const char *>(address) -
+              static_cast<const char *>(info.dli_saddr);
+    return os.str();
+}
+
+void print_phase(std::ostream &os, std::string_view name,
+                 const PhaseStats &stats) {
+    os << "  " << std::left << std::setw(7) << name << std::right
+       << std::setw(12) << stats.allocs << std::setw(12) << stats.frees
+       << std::setw(14) << stats.bytes << std::setw(14) << stats.peak_live
+       << "\n";
+}
+
+} // namespace
+
+void begin_solve() {
+    Lock lock{};
+    start_phase(PARSE);
+    state.phases[SOLVE] = {};
+    state.marked = false;
+    state.live_at_begin = state.live;
+    state.sites.fill({});
+    state.dropped_allocs = 0;
+}
+
+void mark_parsed() {
+    Lock lock{};
+    // only the first call splits the phases
+    if (state.phase == PARSE) {
+        start_phase(SOLVE);
+        state.marked = true;
+    }
+}
+
+void end_solve() {
+    Lock lock{};
+    state.phase = OUTSIDE;
+}
+
+void report(std::ostream &os) {
+    // this allocates, but nothing is recorded per-site or against the
+    // solution's phases while outside of a solve
+    std::vector<Site> sites{};
+    std::array<PhaseStats, NUM_PHASES> phases;
+    long retained, dropped_allocs;
+    {
+        Lock lock{};
+        phases = state.phases;
+        retained = state.live - state.live_at_begin;
+        dropped_allocs = state.dropped_allocs;
+    }
+    // don't count what the driver (or an earlier day) still holds
+    for (PhaseStats &stats : phases) {
+        stats.peak_live -= state.live_at_begin;
+    }
+    for (const Site &site : state.sites) {
+        if (site.address != nullptr) {
+            sites.push_back(site);
+        }
+    }
+    os << "allocations:\n";
+    os << "  phase        allocs       frees         bytes     peak live\n";
+    if (state.marked) {
+        print_phase(os, "parse", phases[PARSE]);
+        print_phase(os, "solve", phases[SOLVE]);
+    } else {
+        // the solution never called mark_parsed()
+        print_phase(os, "total", phases[PARSE]);
+    }
+    os << "  still live after solve: " << retained << " bytes\n";
+
+    constexpr std::size_t MAX_SITES = 10;
+    std::ranges::sort(sites, [](const Site &a, const Site &b) {
+        return a.bytes > b.bytes;
+    });
+    os << "  top call sites by bytes:\n";
+    for (std::size_t i = 0; i < std::min(MAX_SITES, sites.size()); ++i) {
+        os << std::setw(14) << sites[i].bytes << std::setw(10)
+           << sites[i].allocs << "  " << symbolize(sites[i].address) << "\n";
+    }
+    if (sites.size() > MAX_SITES) {
+        os << "  (" << sites.size() - MAX_SITES << " more sites)\n";
+    }
+    if (dropped_allocs > 0) {
+        os << "  (" << dropped_allocs
+           << " allocations from untracked sites, the table is full)\n";
+    }
+}
+
+} // namespace aoc::alloc
+
+// The replacements capture their own return address, which is the call site
+// after inlining (often a container method like vector::_M_realloc_insert).
+
+void *operator new(std::size_t size) {
+    return aoc::alloc::allocate(size, __builtin_return_address(0));
+}
+
+void *operator new[](std::size_t size) {
+    return aoc::alloc::allocate(size, __builtin_return_address(0));
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return aoc::alloc::allocate_nothrow(size, __builtin_return_address(0));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return aoc::alloc::allocate_nothrow(size, __builtin_return_address(0));
+}
+
+void operator delete(void *ptr) noexcept { aoc::alloc::deallocate(ptr); }
+
+void operator delete[](void *ptr) noexcept { aoc::alloc::deallocate(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    aoc::alloc::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    aoc::alloc::deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    aoc::alloc::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    aoc::alloc::deallocate(ptr);
+}
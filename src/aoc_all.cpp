@@ -0,0 +1,97 @@
+/******************************************************************************
+ * File:        aoc_all.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Runs any subset of the days in a single process.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <exception>    // for exception
+#include <iostream>     // for cout, cerr
+#include <optional>     // for optional
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <system_error> // for system_error
+#include <vector>       // for vector
+
+namespace aoc::all {
+
+void usage(const char *argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [-e <example number>|-i <input file name>] [day...]\n";
+}
+
+// runs one day and prints its answers; returns an exit code like the aoc
+// script's
+int run_day(int day, const std::string &input_name) {
+    auto it = aoc::solutions().find(day);
+    if (it == aoc::solutions().end()) {
+        std::cerr << "ERROR: no solution registered for day " << day << "\n";
+        return 1;
+    }
+    const std::string path = aoc::input_path(day, input_name);
+    std::cout << "Day " << day << ":" << std::endl;
+    // only failing to map the input counts as a missing file; errors from
+    // the solution itself are reported below
+    std::optional<aoc::MappedInput> input{};
+    try {
+        input.emplace(path);
+    } catch (const std::system_error &e) {
+        std::cerr << "ERROR: could not read input file at " << path << ": "
+                  << e.what() << "\n";
+        return 2;
+    }
+    try {
+        aoc::instrument::reset();
+        aoc::alloc::begin_solve();
+        it->second(input->view(), std::cout);
+        aoc::alloc::end_solve();
+        aoc::instrument::report(std::cerr);
+        aoc::alloc::report(std::cerr);
+    } catch (const std::exception &e) {
+        std::cerr << "ERROR: day " << day << " failed: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace aoc::all
+
+int main(int argc, char **argv) {
+    using namespace aoc::all;
+    std::string input_name = "input.txt";
+    std::vector<int> days{};
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "-e" || arg == "--example") && i + 1 < argc) {
+            input_name = "example" + std::string(argv[++i]) + ".txt";
+        } else if ((arg == "-i" || arg == "--input") && i + 1 < argc) {
+            input_name = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            usage(argv[0]);
+            return 0;
+        } else if (int day = aoc::parse_day(arg); day != 0) {
+            days.push_back(day);
+        } else {
+            std::cerr << "Error: unrecognized argument '" << arg << "'\n";
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (days.empty()) {
+        // run everything that's linked in
+        for (const auto &[day, solve] : aoc::solutions()) {
+            days.push_back(day);
+        }
+    }
+
+    int exit_code = 0;
+    for (int day : days) {
+        int status = run_day(day, input_name);
+        if (status != 0) {
+            exit_code = status;
+        }
+    }
+    return exit_code;
+}
@@ -0,0 +1,593 @@
+/******************************************************************************
+ * File:        aoc_bench.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Benchmarks the solutions in-process: runs each day's solve()
+ *              repeatedly on an input that has already been read into memory,
+ *              and reports timing statistics for the whole run and for the
+ *              parse and solve phases separately. Optionally reads hardware
+ *              performance counters around each phase with perf_event_open.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <algorithm>          // for sort
+#include <array>              // for array
+#include <cerrno>             // for errno
+#include <chrono>             // for steady_clock, duration
+#include <cmath>              // for sqrt, ceil, isfinite
+#include <cstddef>            // for size_t
+#include <cstdint>            // for uint64_t
+#include <cstdlib>            // for setenv
+#include <cstring>            // for strerror
+#include <exception>          // for exception
+#include <fstream>            // for ofstream
+#include <iomanip>            // for setw, setprecision
+#include <iostream>           // for cout, cerr, fixed, scientific
+#include <limits>             // for numeric_limits
+#include <linux/perf_event.h> // for perf_event_attr, PERF_*
+#include <numeric>            // for accumulate
+#include <optional>           // for optional
+#include <sstream>            // for ostringstream
+#include <stdexcept>          // for runtime_error
+#include <string>             // for string, stoi
+#include <string_view>        // for string_view
+#include <sys/ioctl.h>        // for ioctl
+#include <sys/syscall.h>      // for SYS_perf_event_open
+#include <system_error>       // for system_error
+#include <unistd.h>           // for syscall, read, close
+#include <utility>            // for pair
+#include <vector>             // for vector
+
+namespace aoc::bench {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    int warmup = 1;
+    int runs = 10;
+    std::string input_name = "input.txt";
+    // overrides input_name with a path that's used for every day
+    std::string input_file{};
+    std::string output_file = "bench.json";
+    std::string label{};
+    bool counters = false;
+    std::vector<int> days{};
+};
+
+void usage(const char *argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [-n <runs>] [-w <warmup runs>] [-e <example number>|-i "
+                 "<input file name>|-f <input path>] [-o <JSON file>] [-l "
+                 "<label>] [-c] [day...]\n";
+}
+
+// summary statistics over a set of samples, in seconds
+struct Stats {
+    double min;
+    double median;
+    double p95;
+    double mean;
+    double stddev;
+
+    explicit Stats(std::vector<double> samples);
+};
+
+Stats::Stats(std::vector<double> samples) {
+    std::ranges::sort(samples);
+    const std::size_t n = samples.size();
+    min = samples.front();
+    median = n % 2 == 1 ? samples[n / 2]
+                        : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    // nearest-rank percentile
+    p95 = samples[static_cast<std::size_t>(std::ceil(0.95 * n)) - 1];
+    mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    double sum_sq = 0;
+    for (double x : samples) {
+        sum_sq += (x - mean) * (x - mean);
+    }
+    stddev = n > 1 ? std::sqrt(sum_sq / (n - 1)) : 0.0;
+}
+
+std::ostream &operator<<(std::ostream &os, const Stats &stats) {
+    os << "{\"min\": " << stats.min << ", \"median\": " << stats.median
+       << ", \"p95\": " << stats.p95 << ", \"mean\": " << stats.mean
+       << ", \"stddev\": " << stats.stddev << "}";
+    return os;
+}
+
+enum Counter {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_REFERENCES,
+    CACHE_MISSES,
+    BRANCHES,
+    BRANCH_MISSES,
+    NUM_COUNTERS
+};
+
+constexpr std::array<const char *, NUM_COUNTERS> counter_names{
+    "cycles",       "instructions", "cache_references",
+    "cache_misses", "branches",     "branch_misses"};
+
+// counter values, or deltas between two readings
+using CounterValues = std::array<double, NUM_COUNTERS>;
+
+CounterValues operator-(const CounterValues &lhs, const CounterValues &rhs) {
+    CounterValues result{};
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        result[i] = lhs[i] - rhs[i];
+    }
+    return result;
+}
+
+/**
+ * @brief  A group of hardware performance counters for the calling thread.
+ *
+ * Opens the events in a single group with cycles as the leader, so they're
+ * all scheduled on the PMU together. Events the CPU doesn't support are
+ * skipped (and read as NaN); if the leader itself can't be opened (no PMU in
+ * a VM, perf_event_paranoid too high, seccomp, ...) the whole group is
+ * unavailable and error() says why. Only user-space events from this thread
+ * are counted, so main() runs the solutions on a single thread when these
+ * are enabled.
+ */
+class PerfCounters {
+    int leader = -1;
+    std::array<int, NUM_COUNTERS> fds{};
+    // index of each event in the group's read buffer, in open order
+    std::array<int, NUM_COUNTERS> slots{};
+    int num_open = 0;
+    std::string error_msg{};
+
+  public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available() const { return leader != -1; }
+    const std::string &error() const { return error_msg; }
+    // cumulative values since the group was enabled, scaled up if the kernel
+    // had to multiplex the counters
+    CounterValues read() const;
+};
+
+PerfCounters::PerfCounters() {
+    constexpr std::array<std::uint64_t, NUM_COUNTERS> configs{
+        PERF_COUNT_HW_CPU_CYCLES,       PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES};
+    fds.fill(-1);
+    slots.fill(-1);
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = leader == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader,
+                                PERF_FLAG_FD_CLOEXEC);
+        if (fd == -1) {
+            if (leader == -1) {
+                error_msg = std::string("could not open ") +
+                            counter_names[i] + " counter: " +
+                            std::strerror(errno);
+                return;
+            }
+            continue;
+        }
+        fds[i] = static_cast<int>(fd);
+        slots[i] = num_open++;
+        if (leader == -1) {
+            leader = fds[i];
+        }
+    }
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+}
+
+CounterValues PerfCounters::read() const {
+    // layout for PERF_FORMAT_GROUP: nr, time_enabled, time_running, values
+    std::array<std::uint64_t, 3 + NUM_COUNTERS> buf{};
+    CounterValues values{};
+    values.fill(std::numeric_limits<double>::quiet_NaN());
+    if (::read(leader, buf.data(), sizeof(buf)) == -1) {
+        return values;
+    }
+    const double enabled = buf[1], running = buf[2];
+    const double scale = running > 0 ? enabled / running : 0.0;
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        if (slots[i] != -1) {
+            values[i] = buf[3 + slots[i]] * scale;
+        }
+    }
+    return values;
+}
+
+// median counter values over a set of runs, plus the derived rates
+struct CounterStats {
+    CounterValues median{};
+    double ipc;
+    double llc_miss_rate;
+    double branch_miss_rate;
+
+    explicit CounterStats(const std::vector<CounterValues> &samples);
+};
+
+CounterStats::CounterStats(const std::vector<CounterValues> &samples) {
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        std::vector<double> column{};
+        for (const CounterValues &sample : samples) {
+            column.push_back(sample[i]);
+        }
+        median[i] = Stats{column}.median;
+    }
+    ipc = median[INSTRUCTIONS] / median[CYCLES];
+    llc_miss_rate = median[CACHE_MISSES] / median[CACHE_REFERENCES];
+    branch_miss_rate = median[BRANCH_MISSES] / median[BRANCHES];
+}
+
+// JSON has no NaN, so missing values are written as null
+void write_json_number(std::ostream &os, double value) {
+    if (std::isfinite(value)) {
+        os << value;
+    } else {
+        os << "null";
+    }
+}
+
+std::ostream &operator<<(std::ostream &os, const CounterStats &stats) {
+    os << "{";
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        os << "\"" << counter_names[i] << "\": ";
+        write_json_number(os, stats.median[i]);
+        os << ", ";
+    }
+    os << "\"ipc\": ";
+    write_json_number(os, stats.ipc);
+    os << ", \"llc_miss_rate\": ";
+    write_json_number(os, stats.llc_miss_rate);
+    os << ", \"branch_miss_rate\": ";
+    write_json_number(os, stats.branch_miss_rate);
+    os << "}";
+    return os;
+}
+
+struct DayResult {
+    int day;
+    Stats total;
+    // only present if the solution calls mark_parsed()
+    std::optional<Stats> parse;
+    std::optional<Stats> solve;
+    // only present when running with --counters and they're available
+    std::optional<CounterStats> total_counters{};
+    std::optional<CounterStats> parse_counters{};
+    std::optional<CounterStats> solve_counters{};
+};
+
+// the group used by run_day, and the reading taken at mark_parsed()
+PerfCounters *active_counters = nullptr;
+CounterValues mark_counters{};
+
+void record_mark_counters() { mark_counters = active_counters->read(); }
+
+double seconds_between(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double>(end - start).count();
+}
+
+DayResult run_day(int day, solve_func solve, std::string_view text,
+                  const Options &opts, PerfCounters *counters) {
+    std::vector<double> total{}, parse{}, solve_phase{};
+    std::vector<CounterValues> total_ctrs{}, parse_ctrs{}, solve_ctrs{};
+    active_counters = counters;
+    detail::parse_mark_hook = counters ? record_mark_counters : nullptr;
+    std::string expected{};
+    for (int i = 0; i < opts.warmup + opts.runs; ++i) {
+        // the answers go to a string, so we can check that they don't change
+        std::ostringstream out{};
+        detail::parse_mark = {};
+        CounterValues start_ctrs{}, end_ctrs{};
+        // read the counters just outside the clock, so the clock doesn't
+        // include the read() syscalls
+        if (counters) {
+            start_ctrs = counters->read();
+        }
+        const auto start = Clock::now();
+        solve(text, out);
+        const auto end = Clock::now();
+        if (counters) {
+            end_ctrs = counters->read();
+        }
+        if (i == 0) {
+            expected = out.str();
+        } else if (out.str() != expected) {
+            throw std::runtime_error("answers changed between runs");
+        }
+        if (i < opts.warmup) {
+            continue;
+        }
+        const auto mark = detail::parse_mark;
+        total.push_back(seconds_between(start, end));
+        total_ctrs.push_back(end_ctrs - start_ctrs);
+        if (mark != Clock::time_point{}) {
+            parse.push_back(seconds_between(start, mark));
+            solve_phase.push_back(seconds_between(mark, end));
+            parse_ctrs.push_back(mark_counters - start_ctrs);
+            solve_ctrs.push_back(end_ctrs - mark_counters);
+        }
+    }
+    detail::parse_mark_hook = nullptr;
+    DayResult result{day, Stats{total}, std::nullopt, std::nullopt};
+    if (counters) {
+        result.total_counters.emplace(total_ctrs);
+    }
+    // a solution might only mark some runs if it returns early; don't report
+    // a split based on part of the samples
+    if (parse.size() == total.size()) {
+        result.parse.emplace(parse);
+        result.solve.emplace(solve_phase);
+        if (counters) {
+            result.parse_counters.emplace(parse_ctrs);
+            result.solve_counters.emplace(solve_ctrs);
+        }
+    }
+    return result;
+}
+
+void print_header() {
+    std::cout << "Day";
+    for (const char *column : {"min (ms)", "median", "p95", "stddev",
+                               "parse med", "solve med"}) {
+        std::cout << std::setw(11) << column;
+    }
+    std::cout << "\n";
+}
+
+void print_row(const DayResult &result) {
+    auto ms = [](double seconds) { return seconds * 1000; };
+    std::cout << std::setw(3) << result.day << std::fixed
+              << std::setprecision(3) << std::setw(11) << ms(result.total.min)
+              << std::setw(11) << ms(result.total.median) << std::setw(11)
+              << ms(result.total.p95) << std::setw(11)
+              << ms(result.total.stddev);
+    if (result.parse) {
+        std::cout << std::setw(11) << ms(result.parse->median) << std::setw(11)
+                  << ms(result.solve->median);
+    } else {
+        std::cout << std::setw(11) << "-" << std::setw(11) << "-";
+    }
+    std::cout << "\n";
+    // counter medians go on an indented line per phase, below the timings
+    auto print_counters = [](const char *phase,
+                             const std::optional<CounterStats> &stats) {
+        if (!stats) {
+            return;
+        }
+        // events the CPU doesn't support show up as "-"
+        auto percent = [](double rate) {
+            std::ostringstream ss{};
+            if (std::isfinite(rate)) {
+                ss << std::fixed << std::setprecision(2) << rate * 100 << "%";
+            } else {
+                ss << "-";
+            }
+            return ss.str();
+        };
+        std::cout << std::setw(10) << phase << ":" << std::scientific
+                  << std::setprecision(3) << std::setw(11)
+                  << stats->median[CYCLES] << " cycles, IPC " << std::fixed
+                  << std::setprecision(2) << stats->ipc << ", LLC miss "
+                  << percent(stats->llc_miss_rate) << ", branch miss "
+                  << percent(stats->branch_miss_rate) << "\n";
+    };
+    print_counters("total", result.total_counters);
+    print_counters("parse", result.parse_counters);
+    print_counters("solve", result.solve_counters);
+}
+
+// writes a JSON string literal, escaping quotes, backslashes and control
+// characters
+void write_json_string(std::ostream &os, std::string_view value) {
+    constexpr const char *hex_digits = "0123456789abcdef";
+    os << '"';
+    for (char c : value) {
+        switch (c) {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        case '\t':
+            os << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                os << "\\u00" << hex_digits[c >> 4] << hex_digits[c & 0xf];
+            } else {
+                os << c;
+            }
+            break;
+        }
+    }
+    os << '"';
+}
+
+void write_json(const std::string &filename, const Options &opts,
+                const std::vector<DayResult> &results) {
+    std::ofstream os{filename};
+    os << std::setprecision(9);
+    os << "{\n";
+    os << "  \"label\": ";
+    write_json_string(os, opts.label);
+    os << ",\n  \"input\": ";
+    write_json_string(os, opts.input_file.empty() ? opts.input_name
+                                                  : opts.input_file);
+    os << ",\n";
+    os << "  \"warmup\": " << opts.warmup << ",\n";
+    os << "  \"runs\": " << opts.runs << ",\n";
+    os << "  \"unit\": \"s\",\n";
+    os << "  \"days\": [";
+    bool first = true;
+    for (const DayResult &result : results) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "    {\"day\": " << result.day << ",\n";
+        os << "     \"total\": " << result.total << ",\n";
+        os << "     \"parse\": ";
+        if (result.parse) {
+            os << *result.parse;
+        } else {
+            os << "null";
+        }
+        os << ",\n     \"solve\": ";
+        if (result.solve) {
+            os << *result.solve;
+        } else {
+            os << "null";
+        }
+        os << ",\n     \"counters\": ";
+        if (result.total_counters) {
+            os << "{\"total\": " << *result.total_counters;
+            for (const auto &[phase, stats] :
+                 {std::pair{"parse", &result.parse_counters},
+                  std::pair{"solve", &result.solve_counters}}) {
+                os << ",\n                  \"" << phase << "\": ";
+                if (*stats) {
+                    os << **stats;
+                } else {
+                    os << "null";
+                }
+            }
+            os << "}";
+        } else {
+            os << "null";
+        }
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+std::optional<Options> parse_options(int argc, char **argv) {
+    Options opts{};
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if ((arg == "-n" || arg == "--runs") && has_value) {
+            opts.runs = std::stoi(argv[++i]);
+        } else if ((arg == "-w" || arg == "--warmup") && has_value) {
+            opts.warmup = std::stoi(argv[++i]);
+        } else if ((arg == "-e" || arg == "--example") && has_value) {
+            opts.input_name = "example" + std::string(argv[++i]) + ".txt";
+        } else if ((arg == "-i" || arg == "--input") && has_value) {
+            opts.input_name = argv[++i];
+        } else if ((arg == "-f" || arg == "--file") && has_value) {
+            opts.input_file = argv[++i];
+        } else if ((arg == "-o" || arg == "--output") && has_value) {
+            opts.output_file = argv[++i];
+        } else if ((arg == "-l" || arg == "--label") && has_value) {
+            opts.label = argv[++i];
+        } else if (arg == "-c" || arg == "--counters") {
+            opts.counters = true;
+        } else if (int day = aoc::parse_day(arg); day != 0) {
+            opts.days.push_back(day);
+        } else {
+            if (arg != "-h" && arg != "--help") {
+                std::cerr << "Error: unrecognized argument '" << arg << "'\n";
+            }
+            return std::nullopt;
+        }
+    }
+    if (opts.runs < 1 || opts.warmup < 0) {
+        std::cerr << "Error: need at least one run\n";
+        return std::nullopt;
+    }
+    if (opts.days.empty()) {
+        for (const auto &[day, solve] : aoc::solutions()) {
+            opts.days.push_back(day);
+        }
+    }
+    return opts;
+}
+
+} // namespace aoc::bench
+
+int main(int argc, char **argv) {
+    using namespace aoc::bench;
+    const std::optional<Options> opts = parse_options(argc, argv);
+    if (!opts) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if constexpr (aoc::instrument::ENABLED) {
+        std::cerr << "note: AOC_TIMER and AOC_COUNTER are enabled, so the "
+                     "timings include their overhead\n";
+    }
+    std::optional<PerfCounters> counters{};
+    if (opts->counters) {
+        // the counters only see the calling thread, so keep all the work on
+        // it; this has to happen before anything touches the global pool
+        setenv("AOC_THREADS", "1", 1);
+        counters.emplace();
+        if (!counters->available()) {
+            std::cerr << "warning: hardware counters are unavailable ("
+                      << counters->error() << "), only reporting times\n";
+            counters.reset();
+        }
+    }
+    print_header();
+    int exit_code = 0;
+    std::vector<DayResult> results{};
+    for (int day : opts->days) {
+        auto it = aoc::solutions().find(day);
+        if (it == aoc::solutions().end()) {
+            std::cerr << "ERROR: no solution registered for day " << day
+                      << "\n";
+            exit_code = 1;
+            continue;
+        }
+        const std::string path = opts->input_file.empty()
+                                     ? aoc::input_path(day, opts->input_name)
+                                     : opts->input_file;
+        // read the input once, outside of the timed region
+        std::optional<aoc::MappedInput> input{};
+        try {
+            input.emplace(path);
+        } catch (const std::system_error &e) {
+            std::cerr << "ERROR: could not read input file at " << path
+                      << ": " << e.what() << "\n";
+            exit_code = 2;
+            continue;
+        }
+        try {
+            results.push_back(run_day(day, it->second, input->view(), *opts,
+                                      counters ? &*counters : nullptr));
+            print_row(results.back());
+        } catch (const std::exception &e) {
+            std::cerr << "ERROR: day " << day << " failed: " << e.what()
+                      << "\n";
+            exit_code = 1;
+        }
+    }
+
+    write_json(opts->output_file, *opts, results);
+    std::cerr << "wrote results to " << opts->output_file << "\n";
+    return exit_code;
+}
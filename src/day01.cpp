@@ -6,34 +6,43 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm>  // for sort
-#include <functional> // for greater
-#include <iostream>   // for cout
-#include <numeric>    // for accumulate
-#include <string>     // for string, getline, stoi
-#include <vector>     // for vector
+#include <algorithm>   // for sort
+#include <charconv>    // for from_chars
+#include <functional>  // for greater
+#include <iostream>    // for ostream
+#include <numeric>     // for accumulate
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+namespace aoc::day1 {
+
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
 
     // read file line-by-line
-    std::string line;
+    std::string_view line;
     std::vector<int> calories{0};
-    while (std::getline(infile, line)) {
+    while (input.next_line(line)) {
         if (line.empty()) {
             // new elf
             calories.push_back(0);
         } else {
             // parse calories for this item
-            calories.back() += std::stoi(line);
+            int value = 0;
+            std::from_chars(line.data(), line.data() + line.size(), value);
+            calories.back() += value;
         }
     }
+    aoc::mark_parsed();
     // sort in descending order
     std::ranges::sort(calories, std::greater<int>());
     // part 1
-    std::cout << calories[0] << std::endl;
+    out << calories[0] << std::endl;
     // part 2
-    std::cout << std::accumulate(calories.begin(), calories.begin() + 3, 0)
-              << std::endl;
-    return 0;
+    out << std::accumulate(calories.begin(), calories.begin() + 3, 0)
+        << std::endl;
 }
+
+const SolutionRegistrar registrar{1, solve};
+
+} // namespace aoc::day1
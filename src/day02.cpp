@@ -6,12 +6,16 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <array>    // for array
-#include <cassert>  // for assert
-#include <iostream> // for cout, cerr
+#include <array>       // for array
+#include <cassert>     // for assert
+#include <iostream>    // for ostream, cerr
+#include <string_view> // for string_view
 
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+namespace aoc::day2 {
+
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
     // read file line-by-line
     char opponent_letter, own_letter;
@@ -55,7 +59,10 @@ int main(int argc, char **argv) {
             score[part - 1] += round_score + own_hand;
         }
     }
-    std::cout << score[0] << std::endl;
-    std::cout << score[1] << std::endl;
-    return 0;
+    out << score[0] << std::endl;
+    out << score[1] << std::endl;
 }
+
+const SolutionRegistrar registrar{2, solve};
+
+} // namespace aoc::day2
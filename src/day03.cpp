@@ -6,13 +6,14 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm>  // for sort, set_union, set_intersection
-#include <functional> // for less
-#include <iostream>   // for cout, cerr
-#include <iterator>   // for back_inserter
-#include <string>     // for string, getline
-#include <utility>    // for move
-#include <vector>     // for vector
+#include <algorithm>   // for sort, set_union, set_intersection
+#include <functional>  // for less
+#include <iostream>    // for ostream, cerr
+#include <iterator>    // for back_inserter
+#include <string>      // for string, getline
+#include <string_view> // for string_view
+#include <utility>     // for move
+#include <vector>      // for vector
 
 namespace aoc::day3 {
 
@@ -43,10 +44,9 @@ struct Rucksack {
     }
 };
 
-} // namespace aoc::day3
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
     // read file line-by-line
     std::string line;
@@ -78,7 +78,10 @@ int main(int argc, char **argv) {
             group_size = 0;
         }
     }
-    std::cout << total_1 << std::endl;
-    std::cout << total_2 << std::endl;
-    return 0;
+    out << total_1 << std::endl;
+    out << total_2 << std::endl;
 }
+
+const SolutionRegistrar registrar{3, solve};
+
+} // namespace aoc::day3
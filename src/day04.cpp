@@ -6,10 +6,8 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm> // for replace_if
-#include <iostream>  // for cout
-#include <sstream>   // for stringstream
-#include <string>    // for string, getline
+#include <iostream>    // for ostream
+#include <string_view> // for string_view
 
 namespace aoc::day4 {
 
@@ -18,9 +16,10 @@ struct Assignment {
     int end{-1};
 };
 
-std::istream &operator>>(std::istream &is, Assignment &a) {
-    is >> a.start >> a.end;
-    return is;
+// "<start>-<end>"
+Assignment parse_assignment(std::string_view text) {
+    auto [start, end] = aoc::split_once(text, "-");
+    return {aoc::parse_int(start), aoc::parse_int(end)};
 }
 
 struct Pair {
@@ -38,28 +37,16 @@ struct Pair {
     }
 };
 
-std::istream &operator>>(std::istream &is, Pair &p) {
-    is >> p.first >> p.second;
-    return is;
+// "<assignment>,<assignment>"
+Pair parse_pair(std::string_view line) {
+    auto [first, second] = aoc::split_once(line, ",");
+    return {parse_assignment(first), parse_assignment(second)};
 }
 
-} // namespace aoc::day4
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
-
-    // read file line-by-line
-    std::string line;
+void solve(std::string_view text, std::ostream &out) {
     int include_count = 0, overlap_count = 0;
-    while (std::getline(infile, line)) {
-        using namespace aoc::day4;
-        // simple and stupid: replace '-' and ',' with space
-        std::ranges::replace_if(
-            line, [](char c) { return c == '-' || c == ','; }, ' ');
-        std::stringstream ss{line};
-        // do stuff
-        Pair pair{};
-        ss >> pair;
+    for (std::string_view line : aoc::lines(text)) {
+        Pair pair = parse_pair(line);
 
         if (pair.includes()) {
             ++include_count;
@@ -68,7 +55,10 @@ int main(int argc, char **argv) {
             ++overlap_count;
         }
     }
-    std::cout << include_count << std::endl;
-    std::cout << overlap_count << std::endl;
-    return 0;
+    out << include_count << std::endl;
+    out << overlap_count << std::endl;
 }
+
+const SolutionRegistrar registrar{4, solve};
+
+} // namespace aoc::day4
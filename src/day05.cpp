@@ -6,11 +6,12 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cstddef>  // for size_t
-#include <iostream> // for cout
-#include <list>     // for list
-#include <string>   // for string, getline
-#include <vector>   // for vector
+#include <cstddef>     // for size_t
+#include <iostream>    // for ostream
+#include <list>        // for list
+#include <string>      // for string, getline
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day5 {
 
@@ -23,10 +24,9 @@ void move(Stacks<T> &stacks, int src, int dst) {
     stacks[src].pop_back();
 }
 
-} // namespace aoc::day5
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
     // read and parse initial stacks
     aoc::day5::Stacks<char> stacks{};
@@ -72,12 +72,15 @@ int main(int argc, char **argv) {
         }
     }
     for (const auto &s : stacks) {
-        std::cout << s.back();
+        out << s.back();
     }
-    std::cout << std::endl;
+    out << std::endl;
     for (const auto &s : stacks_2) {
-        std::cout << s.back();
+        out << s.back();
     }
-    std::cout << std::endl;
-    return 0;
+    out << std::endl;
 }
+
+const SolutionRegistrar registrar{5, solve};
+
+} // namespace aoc::day5
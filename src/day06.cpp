@@ -8,7 +8,7 @@
 #include "lib.h"
 #include <cassert>       // for assert
 #include <cstddef>       // for size_t, ptrdiff_t
-#include <iostream>      // for cout, cerr
+#include <iostream>      // for ostream, cerr
 #include <iterator>      // for distance
 #include <string>        // for string, getline
 #include <string_view>   // for string_view
@@ -60,15 +60,18 @@ int find_marker(std::string text, std::size_t window_size) {
     return std::distance(text.cbegin(), new_it);
 }
 
-} // namespace aoc::day6
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
     // read file line-by-line
     std::string line;
     infile >> line;
-    std::cout << aoc::day6::find_marker(line, 4) << std::endl;
-    std::cout << aoc::day6::find_marker(line, 14) << std::endl;
-    return 0;
+    aoc::mark_parsed();
+    out << aoc::day6::find_marker(line, 4) << std::endl;
+    out << aoc::day6::find_marker(line, 14) << std::endl;
 }
+
+const SolutionRegistrar registrar{6, solve};
+
+} // namespace aoc::day6
@@ -6,25 +6,24 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cassert>       // for assert
-#include <iostream>      // for cout, cerr
-#include <memory>        // for shared_ptr, make_shared, weak_ptr,
-                         //     dynamic_pointer_cast, enable_shared_from_this
-#include <sstream>       // for stringstream
-#include <stack>         // for stack
-#include <stdexcept>     // for logic_error
-#include <string>        // for string, getline
-#include <unordered_map> // for unordered_map
-#include <vector>        // for vector
+#include <cassert>         // for assert
+#include <iostream>        // for ostream, cerr
+#include <memory_resource> // for memory_resource
+#include <stack>           // for stack
+#include <stdexcept>       // for logic_error
+#include <string>          // for string
+#include <string_view>     // for string_view
+#include <unordered_map>   // for unordered_map
+#include <vector>          // for vector
 
 namespace aoc::day7 {
 
-class Entity : public std::enable_shared_from_this<Entity> {
+class Entity {
   private:
     Entity() = default;
 
   protected:
-    Entity(const std::string &name, int size = 0) : name(name), size(size){};
+    Entity(std::string_view name, int size = 0) : name(name), size(size){};
 
   public:
     std::string name{};
@@ -32,8 +31,6 @@ class Entity : public std::enable_shared_from_this<Entity> {
 
     virtual ~Entity() = default;
 
-    std::shared_ptr<Entity> getptr() { return shared_from_this(); }
-
     // pure virtual function makes this an abstract class
     virtual void pretty_print(std::ostream &,
                               const std::string &indent = "") const = 0;
@@ -46,7 +43,7 @@ std::ostream &operator<<(std::ostream &os, const Entity &e) {
 
 class File : public Entity {
   public:
-    File(const std::string &name, int size) : Entity(name, size) {}
+    File(std::string_view name, int size) : Entity(name, size) {}
     ~File() = default;
 
     void pretty_print(std::ostream &, const std::string &indent) const override;
@@ -58,43 +55,42 @@ void File::pretty_print(std::ostream &os, const std::string &indent) const {
 }
 
 /// Stores entities in insertion order. Duplicate names are forbidden.
+/// Entities are owned by the arena they were allocated in, which the
+/// directory also uses for its own containers.
 class Directory : public Entity {
   private:
-    std::unordered_map<std::string, int> entity_index{};
-    std::vector<std::shared_ptr<Entity>> contents{};
-    // use a weak reference here to prevent cycles
-    std::weak_ptr<Directory> weak_parent{};
+    std::pmr::unordered_map<std::string, int> entity_index;
+    std::pmr::vector<Entity *> contents;
+    Directory *parent;
 
   public:
-    explicit Directory(const std::string &name) : Entity(name) {}
-    Directory(const std::string &name, std::shared_ptr<Directory> parent)
-        : Entity(name), weak_parent(parent) {}
+    Directory(std::string_view name, std::pmr::memory_resource *resource,
+              Directory *parent = nullptr)
+        : Entity(name), entity_index(resource), contents(resource),
+          parent(parent) {}
 
-    void insert(std::shared_ptr<Entity> ent);
-    std::shared_ptr<Directory> get_subdir(const std::string &name);
+    void insert(Entity *ent);
+    Directory *get_subdir(std::string_view name);
 
     void pretty_print(std::ostream &,
                       const std::string &indent = "") const override;
 };
 
-void Directory::insert(std::shared_ptr<Entity> ent) {
+void Directory::insert(Entity *ent) {
     // try adding the destination index to the lookup
     if (!entity_index.try_emplace(ent->name, contents.size()).second) {
         throw std::logic_error{"Tried to insert a duplicate entity"};
     }
     contents.push_back(ent);
     // update size of this directory and all parent directories up the tree
-    std::shared_ptr<Directory> dir =
-        std::dynamic_pointer_cast<Directory>(getptr());
-    dir->size += ent->size;
-    while ((dir = dir->weak_parent.lock())) {
+    for (Directory *dir = this; dir != nullptr; dir = dir->parent) {
         dir->size += ent->size;
     }
 }
 
-std::shared_ptr<Directory> Directory::get_subdir(const std::string &name) {
-    return std::dynamic_pointer_cast<Directory>(
-        contents[entity_index.at(name)]);
+Directory *Directory::get_subdir(std::string_view name) {
+    return dynamic_cast<Directory *>(
+        contents[entity_index.at(std::string{name})]);
 }
 
 void Directory::pretty_print(std::ostream &os,
@@ -106,27 +102,18 @@ void Directory::pretty_print(std::ostream &os,
     }
 }
 
-} // namespace aoc::day7
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
-
-    using namespace aoc::day7;
-    std::shared_ptr<Directory> root = std::make_shared<Directory>("/");
-    std::vector<std::shared_ptr<Directory>> all_dirs{root};
-    std::stack<std::shared_ptr<Directory>> dirstack;
+void solve(std::string_view text, std::ostream &out) {
+    aoc::Arena arena;
+    Directory *root = arena.make<Directory>("/", &arena);
+    std::vector<Directory *> all_dirs{root};
+    std::stack<Directory *> dirstack;
     dirstack.push(root);
-    // read file line-by-line
-    std::string line;
-    while (std::getline(infile, line)) {
-        std::stringstream ss{line};
-        if (line[0] == '$') { // command
-            char ch;
-            std::string cmd;
-            ss >> ch >> cmd;
+    for (std::string_view line : aoc::lines(text)) {
+        aoc::Scanner scan{line};
+        if (scan.consume('$')) { // command
+            std::string_view cmd = scan.next_token();
             if (cmd == "cd") {
-                std::string dest;
-                ss >> dest;
+                std::string_view dest = scan.next_token();
                 if (dest == "..") {
                     dirstack.pop();
                 } else if (dest == "/") {
@@ -142,19 +129,20 @@ int main(int argc, char **argv) {
                 // ignore command
             }
         } else { // ls output
-            std::string first, name;
-            ss >> first >> name;
+            std::string_view first = scan.next_token();
+            std::string_view name = scan.next_token();
             if (first == "dir") {
-                auto dir = std::make_shared<Directory>(name, dirstack.top());
+                auto *dir = arena.make<Directory>(name, &arena, dirstack.top());
                 dirstack.top()->insert(dir);
                 all_dirs.push_back(dir);
             } else {
-                int size = std::stoi(first);
-                auto file = std::make_shared<File>(name, size);
+                int size = aoc::parse_int(first);
+                auto *file = arena.make<File>(name, size);
                 dirstack.top()->insert(file);
             }
         }
     }
+    aoc::mark_parsed();
 
     if constexpr (aoc::DEBUG) {
         root->pretty_print(std::cerr);
@@ -166,7 +154,7 @@ int main(int argc, char **argv) {
 
     int part_1_total = 0;
     int part_2_min = root->size;
-    for (const auto &dir : all_dirs) {
+    for (const Directory *dir : all_dirs) {
         int size = dir->size;
         // for part 1, we only want the directories with a total size of at most
         // 100,000
@@ -177,7 +165,10 @@ int main(int argc, char **argv) {
             part_2_min = size;
         }
     }
-    std::cout << part_1_total << std::endl;
-    std::cout << part_2_min << std::endl;
-    return 0;
+    out << part_1_total << std::endl;
+    out << part_2_min << std::endl;
 }
+
+const SolutionRegistrar registrar{7, solve};
+
+} // namespace aoc::day7
@@ -6,15 +6,13 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm>  // for count_if
-#include <cassert>    // for assert
-#include <cstdint>    // for uint8_t
-#include <functional> // for plus
-#include <iostream>   // for cout
-#include <numeric>    // for transform_reduce
-#include <string>     // for string, getline
-#include <tuple>      // for tuple
-#include <vector>     // for vector
+#include <algorithm>   // for count_if
+#include <cassert>     // for assert
+#include <cstdint>     // for uint8_t
+#include <iostream>    // for ostream
+#include <string_view> // for string_view
+#include <tuple>       // for tuple
+#include <vector>      // for vector
 
 namespace aoc::day8 {
 
@@ -24,17 +22,19 @@ struct Tree {
     std::uint8_t height : 4;
     bool visible : 1 {false};
 
+    Tree() : height(0) {}
     explicit Tree(std::uint8_t height_) : height(height_) {}
 };
 
 class Forest {
   private:
-    std::vector<std::vector<Tree>> trees{};
+    // indexed by Pos(col, row)
+    aoc::Grid<Tree> trees{};
     int side_length = 0;
 
   public:
     int size() const { return side_length; }
-    void add_row(const std::string &line);
+    void add_row(std::string_view line);
     // Update the visibility of the tree at (r, c) given a tree of height
     // `tallest` in front of it. May also update `tallest`.
     void update_visibility(int r, int c, int &tallest);
@@ -44,18 +44,18 @@ class Forest {
     int calc_scenic_score(int r, int c) const;
 };
 
-void Forest::add_row(const std::string &line) {
+void Forest::add_row(std::string_view line) {
     // add a new row
-    trees.emplace_back();
-    ++side_length;
-    for (char c : line) {
-        // add the tree to the last row
-        trees.back().emplace_back(c - '0');
+    int row = side_length++;
+    trees.expand_to_include(Pos(0, row));
+    trees.expand_to_include(Pos(static_cast<int>(line.size()) - 1, row));
+    for (int col = 0; char c : line) {
+        trees[Pos(col++, row)] = Tree(c - '0');
     }
 }
 
 void Forest::update_visibility(int row, int col, int &tallest) {
-    auto &tree = trees[row][col];
+    auto &tree = trees[Pos(col, row)];
     if (tree.height > tallest) {
         tree.visible = true;
         tallest = tree.height;
@@ -64,8 +64,7 @@ void Forest::update_visibility(int row, int col, int &tallest) {
 
 void Forest::mark_visible() {
     assert(size() > 0);
-    assert(size() == static_cast<int>(trees.size()) &&
-           size() == static_cast<int>(trees[0].size()));
+    assert(size() == trees.height() && size() == trees.width());
     for (int i = 0; i < size(); ++i) {
         int tallest_row = -1, tallest_col = -1;
         for (int j = 0; j < size(); ++j) {
@@ -84,15 +83,16 @@ void Forest::mark_visible() {
 }
 
 int Forest::count_visible() const {
-    return std::transform_reduce(
-        trees.cbegin(), trees.cend(), 0, std::plus{}, [](const auto &row) {
-            return std::ranges::count_if(
-                row, [](const auto &tree) { return tree.visible; });
-        });
+    int count = 0;
+    for (int row = 0; row < size(); ++row) {
+        count += std::ranges::count_if(
+            trees.row(row), [](const auto &tree) { return tree.visible; });
+    }
+    return count;
 }
 
 int Forest::calc_scenic_score(int row, int col) const {
-    int height = trees[row][col].height;
+    int height = trees[Pos(col, row)].height;
     int score = 1;
     // loop over the 4 cardinal directions and increment or decrement the row or
     // column index
@@ -104,7 +104,7 @@ int Forest::calc_scenic_score(int row, int col) const {
         for (int r = row + dr, c = col + dc;
              r >= 0 && r < size() && c >= 0 && c < size(); r += dr, c += dc) {
             ++distance;
-            if (trees[r][c].height >= height) {
+            if (trees[Pos(c, r)].height >= height) {
                 break;
             }
         }
@@ -114,22 +114,20 @@ int Forest::calc_scenic_score(int row, int col) const {
     return score;
 }
 
-} // namespace aoc::day8
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
 
-    using namespace aoc::day8;
     Forest forest{};
 
     // read file line-by-line
-    std::string line;
-    while (std::getline(infile, line)) {
+    std::string_view line;
+    while (input.next_line(line)) {
         // construct tree
         forest.add_row(line);
     }
+    aoc::mark_parsed();
     forest.mark_visible();
-    std::cout << forest.count_visible() << std::endl;
+    out << forest.count_visible() << std::endl;
     int max_scenic_score = 0;
     for (int r = 1; r < forest.size() - 1; ++r) {
         for (int c = 1; c < forest.size() - 1; ++c) {
@@ -139,6 +137,9 @@ int main(int argc, char **argv) {
             }
         }
     }
-    std::cout << max_scenic_score << std::endl;
-    return 0;
+    out << max_scenic_score << std::endl;
 }
+
+const SolutionRegistrar registrar{8, solve};
+
+} // namespace aoc::day8
@@ -5,15 +5,15 @@
  * Created:     2022-12-09
  *****************************************************************************/
 
-#include "lib.h"    // for Pos, Delta, Direction
-#include <array>    // for array
-#include <cassert>  // for assert
-#include <cstdlib>  // for abs
-#include <iostream> // for cout, cerr
-#include <iterator> // for begin, end, cbegin
-#include <set>      // for set
-#include <string>   // for string
-#include <vector>   // for vector
+#include "lib.h"       // for Pos, Delta, Direction, PosSet
+#include <array>       // for array
+#include <cassert>     // for assert
+#include <cstdlib>     // for abs
+#include <iostream>    // for ostream, cerr
+#include <iterator>    // for begin, end, cbegin
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day9 {
 
@@ -65,15 +65,13 @@ void print_rope(std::ostream &os, const T &rope, int width, int height) {
     }
 }
 
-} // namespace aoc::day9
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
-    using namespace aoc::day9;
     std::array<Pos, 10> rope{};
-    std::set<Pos> second_knot_positions{rope[1]};
-    std::set<Pos> tail_positions{rope.back()};
+    aoc::PosSet second_knot_positions{rope[1]};
+    aoc::PosSet tail_positions{rope.back()};
 
     Direction dir;
     int count;
@@ -93,7 +91,10 @@ int main(int argc, char **argv) {
             }
         }
     }
-    std::cout << second_knot_positions.size() << std::endl;
-    std::cout << tail_positions.size() << std::endl;
-    return 0;
+    out << second_knot_positions.size() << std::endl;
+    out << tail_positions.size() << std::endl;
 }
+
+const SolutionRegistrar registrar{9, solve};
+
+} // namespace aoc::day9
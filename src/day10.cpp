@@ -6,14 +6,18 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cassert>  // for assert
-#include <cstdlib>  // for abs
-#include <iostream> // for cout
-#include <string>   // for string, getline
-#include <vector>   // for vector
+#include <cassert>     // for assert
+#include <cstdlib>     // for abs
+#include <iostream>    // for ostream
+#include <string>      // for string, getline
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+namespace aoc::day10 {
+
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
     // read file line-by-line
     std::string command;
@@ -56,9 +60,12 @@ int main(int argc, char **argv) {
             image.back()[beam_pos] = '#';
         }
     }
-    std::cout << sum << std::endl;
+    out << sum << std::endl;
     for (const auto &line : image) {
-        std::cout << line << std::endl;
+        out << line << std::endl;
     }
-    return 0;
 }
+
+const SolutionRegistrar registrar{10, solve};
+
+} // namespace aoc::day10
@@ -6,18 +6,17 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm>  // for ranges::transform, ranges::sort
-#include <cassert>    // for assert
-#include <cstddef>    // for size_t
-#include <deque>      // for deque
-#include <functional> // for function, greater
-#include <iostream>   // for cout, cerr
-#include <iterator>   // for back_inserter
-#include <numeric>    // for lcm, transform_reduce
-#include <sstream>    // for stringstream
-#include <string>     // for string, getline, stoi
-#include <utility>    // for move
-#include <vector>     // for vector
+#include <algorithm>   // for ranges::transform, ranges::sort
+#include <cassert>     // for assert
+#include <cstddef>     // for size_t
+#include <deque>       // for deque
+#include <functional>  // for function, greater
+#include <iostream>    // for ostream, cerr
+#include <iterator>    // for back_inserter
+#include <numeric>     // for lcm, transform_reduce
+#include <string_view> // for string_view
+#include <utility>     // for move
+#include <vector>      // for vector
 
 namespace aoc::day11 {
 
@@ -39,7 +38,7 @@ class Monkey {
     void process_items(std::vector<Monkey> &monkeys, item_t modulus);
     void recieve_item(item_t item) { items.push_back(item); }
 
-    friend std::istream &operator>>(std::istream &, Monkey &);
+    friend aoc::Scanner &operator>>(aoc::Scanner &, Monkey &);
     friend std::ostream &operator<<(std::ostream &,
                                     const std::vector<Monkey> &);
 };
@@ -92,41 +91,29 @@ void Monkey::process_items(std::vector<Monkey> &monkeys, item_t modulus) {
     }
 }
 
-std::istream &operator>>(std::istream &is, Monkey &m) {
-    std::string line;
-
-    // skip any leading whitespace and first line
-    if (!std::getline(is >> std::ws, line)) {
-        return is;
+aoc::Scanner &operator>>(aoc::Scanner &scan, Monkey &m) {
+    // skip first line: "Monkey (n):"
+    if (!scan.skip_tokens(2)) {
+        return scan;
     }
-    assert(line.starts_with("Monkey "));
-
-    // read starting items line
-    std::getline(is, line);
-    assert(line.starts_with("  Starting items:"));
-    std::istringstream ss{line};
-    // skip first two words: "Starting items:"
-    ss >> aoc::skip(2);
-    while (true) {
-        item_t item;
-        char comma;
-        assert(ss >> item);
+
+    // read starting items line: "Starting items: (item), (item), ..."
+    scan.skip_tokens(2);
+    do {
+        item_t item = scan.next_int<item_t>();
+        assert(scan);
         m.recieve_item(item);
         // try reading the comma before the next item
-        if (!(ss >> comma)) {
-            break;
-        }
-    }
+    } while (scan.consume(','));
 
     // read operation line: "Operation: new = old (operator) (operand)"
-    char op;
-    std::string operand;
-    is >> aoc::skip(4) >> op >> operand;
+    char op = scan.skip_tokens(4).next_char();
+    std::string_view operand = scan.next_token();
     if (operand == "old") {
         assert(op == '*');
         m.operation = [](item_t old) { return old * old; };
     } else {
-        int value = std::stoi(operand);
+        int value = aoc::Scanner{operand}.next_int();
         switch (op) {
         case '+':
             m.operation = [=](item_t old) { return old + value; };
@@ -140,15 +127,15 @@ std::istream &operator>>(std::istream &is, Monkey &m) {
     }
 
     // read test line: "Test: divisible by (divisor)"
-    is >> aoc::skip(3) >> m.divisor;
+    m.divisor = scan.skip_tokens(3).next_int<item_t>();
 
     // read true line: "If true: throw to monkey (true_dest)"
-    is >> aoc::skip(5) >> m.true_dest;
+    m.true_dest = scan.skip_tokens(5).next_int();
 
     // read false line: "If false: throw to monkey (false_dest)"
-    is >> aoc::skip(5) >> m.false_dest;
+    m.false_dest = scan.skip_tokens(5).next_int();
 
-    return is;
+    return scan;
 }
 
 std::ostream &operator<<(std::ostream &os, const std::vector<Monkey> &monkeys) {
@@ -204,26 +191,24 @@ item_t do_monkey_business(std::vector<Monkey> monkeys, int num_rounds,
     return inspect_counts[0] * inspect_counts[1];
 }
 
-} // namespace aoc::day11
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::Scanner scan{text};
 
-    using namespace aoc::day11;
     std::vector<Monkey> monkeys{};
     while (true) {
         Monkey monkey;
-        if (!(infile >> monkey)) {
+        if (!(scan >> monkey)) {
             break;
         }
         monkeys.push_back(std::move(monkey));
     }
+    aoc::mark_parsed();
     if constexpr (verbose) {
         std::cerr << monkeys << std::endl;
     }
 
     // part 1
-    std::cout << do_monkey_business<true>(monkeys, 20) << std::endl;
+    out << do_monkey_business<true>(monkeys, 20) << std::endl;
 
     // find the LCM of all the monkeys' divisors
     item_t modulus = std::transform_reduce(
@@ -231,8 +216,9 @@ int main(int argc, char **argv) {
         [](const Monkey &m) { return m.divisor; });
 
     // part 2
-    std::cout << do_monkey_business<false>(monkeys, 10000, modulus)
-              << std::endl;
-
-    return 0;
+    out << do_monkey_business<false>(monkeys, 10000, modulus) << std::endl;
 }
+
+const SolutionRegistrar registrar{11, solve};
+
+} // namespace aoc::day11
@@ -6,177 +6,79 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <iostream>  // for cout
-#include <limits>    // for numeric_limits
-#include <map>       // for map
-#include <memory>    // for unique_ptr
-#include <queue>     // for queue
-#include <stdexcept> // for logic_error
-#include <utility>   // for move
+#include <array>       // for array
+#include <cstddef>     // for size_t, ptrdiff_t
+#include <iostream>    // for ostream, cerr, endl
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day12 {
 
-template <typename T>
-class LinkedGrid {
-  public: // member types
-    using value_type = T;
-    using data_pointer = std::unique_ptr<T>;
+// cells past the edge of the map are too low to climb down to
+constexpr int OFF_MAP = -2;
 
-    struct Node {
-      private:
-        data_pointer data;
-
-      public:
-        std::weak_ptr<Node> north{}, south{}, east{}, west{};
-
-      public:
-        explicit Node(data_pointer data) : data(std::move(data)) {}
-
-        T &operator*() { return *data; }
-        const T &operator*() const { return *data; }
-        T *operator->() { return data.get(); }
-        const T *operator->() const { return data.get(); }
-    };
-
-    using node_pointer = std::shared_ptr<Node>;
-
-  private:
-    std::map<Pos, node_pointer> nodes{};
-
-  public:
-    node_pointer add_node(const Pos &, data_pointer);
-};
-
-template <typename T>
-typename LinkedGrid<T>::node_pointer
-LinkedGrid<T>::add_node(const Pos &pos, LinkedGrid<T>::data_pointer data) {
-    if (nodes.contains(pos)) {
-        throw std::logic_error("Grid node already exists at this position");
+void solve(std::string_view text, std::ostream &out) {
+    std::vector<std::string_view> rows{};
+    for (std::string_view line : aoc::lines(text)) {
+        rows.push_back(line);
     }
-    auto node = make_shared<Node>(std::move(data));
-    nodes.emplace(pos, node);
-    // link adjacent nodes
-    for (Direction dir :
-         {Direction::up, Direction::down, Direction::right, Direction::left}) {
-        auto other = nodes.find(pos + Delta(dir));
-        if (other != nodes.end()) {
-            switch (dir) {
-            case Direction::up:
-                node->north = other->second;
-                other->second->south = node;
-                break;
-            case Direction::down:
-                node->south = other->second;
-                other->second->north = node;
-                break;
-            case Direction::right:
-                node->east = other->second;
-                other->second->west = node;
-                break;
-            case Direction::left:
-                node->west = other->second;
-                other->second->east = node;
-                break;
+    aoc::Grid<int> heights(rows[0].size(), rows.size(), OFF_MAP, 1);
+    aoc::Pos start, end;
+    for (int y = 0; y < heights.height(); ++y) {
+        for (int x = 0; x < heights.width(); ++x) {
+            char c = rows[y][x];
+            if (c == 'S') {
+                start = {x, y};
+                c = 'a';
+            } else if (c == 'E') {
+                end = {x, y};
+                c = 'z';
             }
+            heights[{x, y}] = c - 'a';
         }
     }
-    return node;
-}
-
-struct NodeData {
-    int height;
-    int distance{std::numeric_limits<decltype(distance)>::max()};
-    bool visited{false};
+    aoc::mark_parsed();
 
-    explicit NodeData(int height) : height(height) {}
-};
-
-int bfs(LinkedGrid<NodeData>::node_pointer &end) {
-    std::queue<LinkedGrid<NodeData>::node_pointer> queue{{end}};
-    (*end)->distance = 0;
+    std::array<std::ptrdiff_t, 4> offsets;
+    for (std::size_t i = 0; aoc::Direction dir :
+                            {aoc::Direction::up, aoc::Direction::down,
+                             aoc::Direction::right, aoc::Direction::left}) {
+        offsets[i++] = heights.index_offset(aoc::Delta(dir));
+    }
+    // perform a BFS over the grid starting from `end`, until it reaches
+    // `start`; along the way, the first node with height 0 is the closest one
+    const std::size_t start_index = heights.index_of(start);
+    int closest_a = -1;
     int curr_distance = -1;
-    int closest_a = std::numeric_limits<int>::max();
-    while (!queue.empty()) {
-        LinkedGrid<NodeData>::Node &node = *queue.front();
-        queue.pop();
-        if (node->visited) {
-            continue;
-        }
-        node->visited = true;
-        if (node->height == 0 && node->distance < closest_a) {
-            closest_a = node->distance;
-        }
-        if (node->distance > curr_distance) {
-            curr_distance = node->distance;
-            if constexpr (aoc::DEBUG) {
-                std::cerr << "now processing distance " << curr_distance
-                          << " nodes..." << std::endl;
-            }
-        }
-
-        for (auto weak_neighbor :
-             {node.north, node.east, node.south, node.west}) {
-            if (auto neighbor_ptr = weak_neighbor.lock()) {
-                LinkedGrid<NodeData>::Node &neighbor = *neighbor_ptr;
-                // neighbor exists
-                if (node->height > neighbor->height + 1) {
-                    // too steep
-                    continue;
+    aoc::GraphSearch search;
+    search.bfs(
+        heights.num_indices(), {heights.index_of(end)},
+        [&](std::size_t node, auto push) {
+            for (std::ptrdiff_t offset : offsets) {
+                std::size_t neighbor = node + offset;
+                if (heights.cell(node) <= heights.cell(neighbor) + 1) {
+                    push(neighbor);
                 }
-                if (neighbor->distance <= node->distance) {
-                    // already visited
-                    continue;
+            }
+        },
+        [&](std::size_t node, int distance) {
+            if constexpr (aoc::DEBUG) {
+                if (distance > curr_distance) {
+                    curr_distance = distance;
+                    std::cerr << "now processing distance " << curr_distance
+                              << " nodes..." << std::endl;
                 }
-                // update the neighbor's distance from the end and add it to
-                // the queue
-                neighbor->distance = node->distance + 1;
-                queue.push(neighbor_ptr);
             }
-        }
-    }
-    return closest_a;
-}
-
-} // namespace aoc::day12
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
-
-    using namespace aoc::day12;
-    LinkedGrid<NodeData> grid{};
-    LinkedGrid<NodeData>::node_pointer start{};
-    LinkedGrid<NodeData>::node_pointer end{};
+            if (closest_a < 0 && heights.cell(node) == 0) {
+                closest_a = distance;
+            }
+            return node == start_index;
+        });
 
-    aoc::Pos start_of_line{0, 0};
-    aoc::Pos curr_pos{start_of_line};
-    // read file character-by-character
-    char c;
-    while (infile.get(c)) {
-        if (c == '\n') {
-            start_of_line += aoc::Delta(aoc::Direction::down);
-            curr_pos = start_of_line;
-            continue;
-        }
-        int height = c - 'a';
-        if (c == 'S') {
-            height = 0;
-        } else if (c == 'E') {
-            height = 'z' - 'a';
-        }
-        auto node = grid.add_node(curr_pos, std::make_unique<NodeData>(height));
-        if (c == 'S') {
-            start = node;
-        } else if (c == 'E') {
-            end = node;
-        }
-        curr_pos += aoc::Delta(aoc::Direction::right);
-    }
-    // perform a BFS over the grid starting from `end`
-    // at the same time, find the lowest distance among nodes with height == 0
-    int closest_a = bfs(end);
+    out << search.distance(start_index) << std::endl;
+    out << closest_a << std::endl;
+}
 
-    std::cout << (*start)->distance << std::endl;
-    std::cout << closest_a << std::endl;
+const SolutionRegistrar registrar{12, solve};
 
-    return 0;
-}
+} // namespace aoc::day12
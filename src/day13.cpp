@@ -11,8 +11,9 @@
 #include <compare>          // for strong_ordering
 #include <cstddef>          // for size_t
 #include <initializer_list> // for initializer_list
-#include <iostream>         // for cout
+#include <iostream>         // for ostream
 #include <iterator>         // for distance
+#include <string_view>      // for string_view
 #include <utility>          // for move
 #include <vector>           // for vector
 
@@ -133,12 +134,10 @@ std::weak_ordering operator<=>(const Packet &lhs, const Packet &rhs) {
     assert(false);
 }
 
-} // namespace aoc::day13
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
-    using namespace aoc::day13;
     Packet left, right;
     std::vector<Packet> packets;
     int result = 0;
@@ -160,7 +159,7 @@ int main(int argc, char **argv) {
         packets.push_back(std::move(left));
         packets.push_back(std::move(right));
     }
-    std::cout << result << std::endl;
+    out << result << std::endl;
 
     // add divider packets
     Packet divider_start({Packet({Packet(2)})});
@@ -174,6 +173,9 @@ int main(int argc, char **argv) {
         packets.begin(), std::ranges::upper_bound(packets, divider_start));
     int end_idx = std::distance(packets.begin(),
                                 std::ranges::upper_bound(packets, divider_end));
-    std::cout << start_idx * end_idx << std::endl;
-    return 0;
+    out << start_idx * end_idx << std::endl;
 }
+
+const SolutionRegistrar registrar{13, solve};
+
+} // namespace aoc::day13
@@ -6,13 +6,11 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm> // for minmax
-#include <cassert>   // for assert
-#include <iostream>  // for cout
-#include <sstream>   // for istringstream
-#include <string>    // for string, getline
-#include <utility>   // for pair
-#include <vector>    // for vector
+#include <algorithm>   // for minmax
+#include <cassert>     // for assert
+#include <iostream>    // for ostream
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day14 {
 
@@ -39,11 +37,9 @@ class Grid {
     static constexpr int min_y = 0;
     int min_x{INITIAL_X}, max_x{INITIAL_X}, max_y{INITIAL_Y};
 
-    std::vector<std::vector<CellType>> cells;
+    // the halo lets a grain step one cell past the edges without any checks
+    aoc::Grid<CellType> cells;
 
-    constexpr std::pair<int, int> lookup_pos(int x, int y) const {
-        return {y, x - min_x};
-    }
     void add_line(int x1, int y1, int x2, int y2);
     void place_sand(int x, int y);
 
@@ -85,8 +81,8 @@ Grid::Grid(const std::vector<std::vector<aoc::Pos>> &scan) {
     // a larger grid is needed for part 2
     max_x = std::max(INITIAL_X + (max_y + 2) + 1, max_x);
     min_x = std::min(INITIAL_X - (max_y + 2) - 1, min_x);
-    cells.resize((max_y + 2) - min_y + 1,
-                 std::vector<CellType>(max_x - min_x + 1, CellType::air));
+    cells = aoc::Grid<CellType>(max_x - min_x + 1, (max_y + 2) - min_y + 1,
+                                CellType::air, 1, Pos(min_x, min_y));
     for (const auto &path : scan) {
         auto pos_1 = path.cbegin();
         auto pos_2 = pos_1 + 1;
@@ -102,41 +98,35 @@ void Grid::setup_part_2() {
 }
 
 void Grid::add_line(int x1, int y1, int x2, int y2) {
-    auto [r1, c1] = lookup_pos(x1, y1);
-    auto [r2, c2] = lookup_pos(x2, y2);
-    if (c1 != c2) {
+    if (x1 != x2) {
         // horizontal
-        assert(r1 == r2);
-        auto [clo, chi] = std::minmax(c1, c2);
-        for (int c = clo; c <= chi; ++c) {
-            cells[r1][c] = CellType::stone;
+        assert(y1 == y2);
+        auto [xlo, xhi] = std::minmax(x1, x2);
+        for (int x = xlo; x <= xhi; ++x) {
+            cells[Pos(x, y1)] = CellType::stone;
         }
-    } else if (r1 != r2) {
+    } else if (y1 != y2) {
         // vertical
-        assert(c1 == c2);
-        auto [rlo, rhi] = std::minmax(r1, r2);
-        for (int r = rlo; r <= rhi; ++r) {
-            cells[r][c1] = CellType::stone;
+        assert(x1 == x2);
+        auto [ylo, yhi] = std::minmax(y1, y2);
+        for (int y = ylo; y <= yhi; ++y) {
+            cells[Pos(x1, y)] = CellType::stone;
         }
     } else {
         // path with length 1
-        cells[r1][c1] = CellType::stone;
+        cells[Pos(x1, y1)] = CellType::stone;
     }
 }
 
 void Grid::place_sand(int x, int y) {
-    auto [row, col] = lookup_pos(x, y);
-    std::vector<CellType>::reference value = cells[row][col];
+    CellType &value = cells[Pos(x, y)];
     assert(value == CellType::air);
     value = CellType::sand;
 }
 
 bool Grid::open(int x, int y) const {
-    if (over_abyss(x, y)) {
-        return true;
-    }
-    auto [row, col] = lookup_pos(x, y);
-    return cells[row][col] == CellType::air;
+    // everything past the edges (including the halo) is air
+    return cells[Pos(x, y)] == CellType::air;
 }
 
 bool Grid::over_abyss(int x, int y) const {
@@ -145,8 +135,8 @@ bool Grid::over_abyss(int x, int y) const {
 }
 
 std::ostream &operator<<(std::ostream &os, const Grid &grid) {
-    for (const auto &row : grid.cells) {
-        for (const auto &cell : row) {
+    for (int y = grid.cells.y_min(); y <= grid.cells.y_max(); ++y) {
+        for (const auto &cell : grid.cells.row(y)) {
             os << cell;
         }
         os << '\n';
@@ -189,26 +179,24 @@ bool Grid::add_sand_grain() {
     return true;
 }
 
-} // namespace aoc::day14
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
-
-    using namespace aoc::day14;
-    // read file line-by-line
-    std::string line;
+void solve(std::string_view text, std::ostream &out) {
     std::vector<std::vector<aoc::Pos>> scan{};
-    int x, y;
-    while (std::getline(infile, line)) {
-        std::istringstream ss{line};
+    for (std::string_view line : aoc::lines(text)) {
         scan.emplace_back();
-        while (ss >> x >> aoc::skip<char>() >> y) {
+        for (aoc::Scanner points{line}; !points.at_end();) {
+            int x = points.next_int();
+            points.consume(',');
+            int y = points.next_int();
+            if (!points) {
+                break;
+            }
             scan.back().emplace_back(x, y);
             // skip "->"
-            ss >> aoc::skip(1);
+            points.next_token();
         }
     }
     Grid grid{scan};
+    aoc::mark_parsed();
     if constexpr (aoc::DEBUG) {
         std::cerr << grid << std::endl;
     }
@@ -219,11 +207,14 @@ int main(int argc, char **argv) {
             std::cerr << grid << std::endl;
         }
     }
-    std::cout << i << std::endl;
+    out << i << std::endl;
 
     grid.setup_part_2();
     for (; grid.add_sand_grain(); ++i)
         ;
-    std::cout << i << std::endl;
-    return 0;
+    out << i << std::endl;
 }
+
+const SolutionRegistrar registrar{14, solve};
+
+} // namespace aoc::day14
@@ -6,18 +6,21 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm> // for count_if
-#include <cassert>   // for assert
-#include <cstdlib>   // for abs
-#include <iostream>  // for cout, cerr
-#include <iterator>  // for next
-#include <map>       // for map
-#include <memory>    // for shared_ptr, make_shared
-#include <regex>     // for regex, regex_match, smatch
-#include <set>       // for set
-#include <stdexcept> // for domain_error
-#include <string>    // for string, getline, stoi
-#include <vector>    // for vector
+#include <algorithm>   // for count_if
+#include <cassert>     // for assert
+#include <cstdint>     // for uint32_t
+#include <cstdlib>     // for abs
+#include <iostream>    // for ostream, cerr
+#include <iterator>    // for next
+#include <map>         // for map
+#include <memory>      // for shared_ptr, make_shared
+#include <optional>    // for optional
+#include <regex>       // for regex, regex_match, smatch
+#include <span>        // for span
+#include <stdexcept>   // for domain_error
+#include <string>      // for string, getline, stoi
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day15 {
 
@@ -223,7 +226,7 @@ int RangeLookup::count_covered() const {
     return count;
 }
 
-bool part_2_helper(const std::vector<Sensor> &sensors, const Pos &p,
+bool part_2_helper(std::span<const Sensor> sensors, const Pos &p,
                    int max_coord) {
     if (p.x < 0 || p.x > max_coord || p.y < 0 || p.y > max_coord) {
         return false;
@@ -236,7 +239,7 @@ bool part_2_helper(const std::vector<Sensor> &sensors, const Pos &p,
     return true;
 }
 
-Pos solve_part_2(const std::vector<Sensor> &sensors, int max_coord) {
+Pos solve_part_2(std::span<const Sensor> sensors, int max_coord) {
     // for each sensor, check each point just outside the perimeter
     for (const Sensor &sensor : sensors) {
         Pos north{sensor.position}, east{sensor.position},
@@ -277,14 +280,11 @@ Pos solve_part_2(const std::vector<Sensor> &sensors, int max_coord) {
     assert(false);
 }
 
-} // namespace aoc::day15
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+std::vector<Sensor> read_sensors(std::string_view text) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
-    using namespace aoc::day15;
     std::vector<Sensor> sensors{};
-    std::set<Pos> beacons{};
     // read file line-by-line
     std::string line;
     std::regex line_regex{
@@ -295,7 +295,6 @@ int main(int argc, char **argv) {
             Pos sensor_pos{std::stoi(line_match[1]), std::stoi(line_match[2])};
             Pos beacon_pos{std::stoi(line_match[3]), std::stoi(line_match[4])};
             sensors.emplace_back(sensor_pos, beacon_pos);
-            beacons.insert(beacon_pos);
             if constexpr (aoc::DEBUG) {
                 std::cerr << "sensor at " << sensors.back().position
                           << ", nearest beacon at "
@@ -304,6 +303,31 @@ int main(int argc, char **argv) {
             }
         }
     }
+    return sensors;
+}
+
+// layout version of the sensor records in the input cache
+constexpr std::uint32_t CACHE_VERSION = 1;
+
+void solve(std::string_view text, std::ostream &out) {
+    // the sensors either point into the input cache, or into parsed_sensors
+    std::vector<Sensor> parsed_sensors{};
+    std::span<const Sensor> sensors;
+    std::optional<aoc::InputCache> cache =
+        aoc::InputCache::load(text, 15, CACHE_VERSION);
+    if (cache) {
+        sensors = cache->section<Sensor>(0);
+    } else {
+        parsed_sensors = read_sensors(text);
+        aoc::InputCacheWriter{}.add(parsed_sensors).save(text, 15,
+                                                         CACHE_VERSION);
+        sensors = parsed_sensors;
+    }
+    aoc::PosSet beacons{};
+    for (const Sensor &sensor : sensors) {
+        beacons.insert(sensor.nearest_beacon);
+    }
+    aoc::mark_parsed();
     int target_row = 2000000;
     if (sensors.size() == 14 && sensors.front().position == Pos(2, 18)) {
         // example uses a different value
@@ -326,7 +350,7 @@ int main(int argc, char **argv) {
             }
         }
     }
-    std::cout << lookup.count_covered() - num_beacons << std::endl;
+    out << lookup.count_covered() - num_beacons << std::endl;
 
     /* Part 2 strategy:
      * Given that there's only one possible position, it must be just outside
@@ -336,7 +360,9 @@ int main(int argc, char **argv) {
      */
 
     Pos beacon_pos = solve_part_2(sensors, target_row * 2);
-    std::cout << beacon_pos.x * 4000000L + beacon_pos.y << std::endl;
-
-    return 0;
+    out << beacon_pos.x * 4000000L + beacon_pos.y << std::endl;
 }
+
+const SolutionRegistrar registrar{15, solve};
+
+} // namespace aoc::day15
@@ -6,16 +6,22 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm> // for find_if, min
-#include <array>     // for array
-#include <cassert>   // for assert
-#include <iostream>  // for cout, cerr
-#include <limits>    // for numeric_limits
-#include <map>       // for map
-#include <memory>    // for unique_ptr, make_unique
-#include <regex>     // for regex, smatch, regex_search, sregex_iterator
-#include <string>    // for string, getline, stoi
-#include <vector>    // for vector
+#include <algorithm>     // for min, max, max_element, sort, transform, ...
+#include <array>         // for array
+#include <cassert>       // for assert
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstdlib>       // for getenv
+#include <iostream>      // for ostream, cerr
+#include <limits>        // for numeric_limits
+#include <memory>        // for unique_ptr, make_unique
+#include <optional>      // for optional
+#include <stdexcept>     // for invalid_argument, out_of_range
+#include <string>        // for string
+#include <string_view>   // for string_view
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move
+#include <vector>        // for vector
 
 namespace aoc::day16 {
 
@@ -23,11 +29,11 @@ using Key = unsigned int;
 
 struct Valve;
 
+// every tunnel in the input takes one minute to walk through
 struct Tunnel {
-    int length;
     Valve *valve;
 
-    Tunnel(int length, Valve *valve) : length(length), valve(valve) {}
+    explicit Tunnel(Valve *valve) : valve(valve) {}
 
     Valve &operator*() { return *valve; }
     const Valve &operator*() const { return *valve; }
@@ -45,52 +51,116 @@ struct Valve {
         : flow_rate(-1), name(name), key(key) {}
     Valve(int flow_rate, const std::string &name, Key key)
         : flow_rate(flow_rate), name(name), key(key) {}
-
-    std::vector<Tunnel>::iterator get_tunnel_to(const Valve *);
 };
 
-std::vector<Tunnel>::iterator Valve::get_tunnel_to(const Valve *other) {
-    return std::find_if(
-        tunnels.begin(), tunnels.end(),
-        [=](const Tunnel &tunnel) { return tunnel.valve == other; });
-}
+// input cache records for the graph as it was read
+struct CachedValve {
+    std::array<char, 2> name;
+    int flow_rate;
+    // range of this valve's entries in the tunnel section
+    Key first_tunnel;
+    Key num_tunnels;
+};
 
 struct Graph {
-    std::map<std::string, Key> name_lookup;
+    // every two-letter name, AA to ZZ
+    static constexpr std::size_t NUM_NAMES = 26 * 26;
+    static constexpr Key NO_VALVE = -1;
+
+    // name_index(name) -> key, or NO_VALVE
+    std::array<Key, NUM_NAMES> name_lookup;
     std::vector<std::unique_ptr<Valve>> valves;
 
-    Valve *get_valve_by_name(const std::string &name) {
-        auto it = name_lookup.find(name);
-        if (it == name_lookup.end()) {
-            it = name_lookup.emplace(name, valves.size()).first;
-            valves.emplace_back(std::make_unique<Valve>(name, valves.size()));
+    // layout version of the records in the input cache
+    static constexpr std::uint32_t CACHE_VERSION = 1;
+
+    Graph() { name_lookup.fill(NO_VALVE); }
+
+    static std::size_t name_index(std::string_view name) {
+        assert(name.size() == 2 && name[0] >= 'A' && name[0] <= 'Z' &&
+               name[1] >= 'A' && name[1] <= 'Z');
+        return (name[0] - 'A') * 26 + (name[1] - 'A');
+    }
+
+    Key key_of(std::string_view name) const {
+        const Key key = name_lookup[name_index(name)];
+        if (key == NO_VALVE) {
+            throw std::out_of_range("no valve named " + std::string{name});
         }
-        return valves[it->second].get();
+        return key;
     }
 
-    // collapse valves with zero flow rate
-    void simplify();
+    Valve *get_valve_by_name(std::string_view name) {
+        Key &key = name_lookup[name_index(name)];
+        if (key == NO_VALVE) {
+            key = valves.size();
+            valves.emplace_back(
+                std::make_unique<Valve>(std::string{name}, valves.size()));
+        }
+        return valves[key].get();
+    }
 
-    void read_line(const std::string &);
+    void read_line(std::string_view line);
     void output_graphviz(std::ostream &);
+
+    // sections: CachedValve records, then the key each tunnel leads to
+    void write_cache(std::string_view text) const;
+    void read_cache(const aoc::InputCache &cache);
 };
 
-void Graph::read_line(const std::string &line) {
-    static std::regex number_regex{"\\d+"};
-    static std::regex valve_regex{"[A-Z]{2}"};
-
-    std::smatch number_match;
-    assert(std::regex_search(line, number_match, number_regex));
-    int flow_rate = std::stoi(number_match[0]);
-    auto valve_iter =
-        std::sregex_iterator(line.cbegin(), line.cend(), valve_regex);
-    auto valves_end = std::sregex_iterator();
-    Valve *valve = get_valve_by_name(valve_iter->str());
-    ++valve_iter;
+// Valve AA has flow rate=0; tunnels lead to valves DD, II, BB
+// Valve HH has flow rate=22; tunnel leads to valve GG
+void Graph::read_line(std::string_view line) {
+    aoc::Scanner scan{line};
+    Valve *valve = get_valve_by_name(scan.skip_tokens(1).next_token());
+    const int flow_rate = scan.skip_until('=').next_int();
+    // "tunnel(s) lead(s) to valve(s)"
+    scan.skip_until(';').skip_tokens(4);
+    assert(scan);
     assert(valve->flow_rate == -1);
     valve->flow_rate = flow_rate;
-    for (; valve_iter != valves_end; ++valve_iter) {
-        valve->tunnels.emplace_back(1, get_valve_by_name(valve_iter->str()));
+    while (!scan.at_end()) {
+        std::string_view name = scan.next_token();
+        if (name.ends_with(',')) {
+            name.remove_suffix(1);
+        }
+        valve->tunnels.emplace_back(get_valve_by_name(name));
+    }
+}
+
+void Graph::write_cache(std::string_view text) const {
+    std::vector<CachedValve> cached_valves{};
+    std::vector<Key> tunnel_keys{};
+    for (const auto &valve : valves) {
+        assert(valve->name.size() == 2);
+        cached_valves.push_back({{valve->name[0], valve->name[1]},
+                                 valve->flow_rate,
+                                 static_cast<Key>(tunnel_keys.size()),
+                                 static_cast<Key>(valve->tunnels.size())});
+        for (const Tunnel &tunnel : valve->tunnels) {
+            tunnel_keys.push_back(tunnel->key);
+        }
+    }
+    aoc::InputCacheWriter{}.add(cached_valves).add(tunnel_keys).save(
+        text, 16, CACHE_VERSION);
+}
+
+void Graph::read_cache(const aoc::InputCache &cache) {
+    const auto cached_valves = cache.section<CachedValve>(0);
+    const auto tunnel_keys = cache.section<Key>(1);
+    // create all the valves first, so the tunnels can point to them
+    for (const CachedValve &cached : cached_valves) {
+        const std::string name{cached.name.data(), cached.name.size()};
+        name_lookup[name_index(name)] = valves.size();
+        valves.emplace_back(
+            std::make_unique<Valve>(cached.flow_rate, name, valves.size()));
+    }
+    for (Key key = 0; key < valves.size(); ++key) {
+        const CachedValve &cached = cached_valves[key];
+        for (Key target :
+             tunnel_keys.subspan(cached.first_tunnel, cached.num_tunnels)) {
+            valves[key]->tunnels.emplace_back(valves[target].get());
+        }
     }
 }
 
@@ -105,158 +175,94 @@ void Graph::output_graphviz(std::ostream &os) {
             os << "\"]\n";
         }
         for (const Tunnel &neighbor : valve->tunnels) {
-            os << "  " << key << " -- " << neighbor->key;
-            if (neighbor.length > 1) {
-                os << " [label=\"" << neighbor.length << "\"]";
-            }
-            os << "\n";
+            os << "  " << key << " -- " << neighbor->key << "\n";
         }
     }
     os << "}\n";
 }
 
-void Graph::simplify() {
-    // loop over all nodes and collapse the ones with zero flow (except for AA)
-    for (Key key = valves.size() - 1; key-- != 0;) {
-        Valve *valve = valves[key].get();
-        if (valve->name == "AA" || valve->flow_rate > 0) {
-            continue;
-        }
-        if (valve->tunnels.size() != 2) {
-            // ignore branching valves
-            continue;
-        }
-        const Tunnel &tunnel_1 = valve->tunnels[0];
-        const Tunnel &tunnel_2 = valve->tunnels[1];
-        int new_length = tunnel_1.length + tunnel_2.length;
-        // relink valve connected to tunnel 1 to valve connected to tunnel 2
-        auto tunnel_1_reverse = tunnel_1.valve->get_tunnel_to(valve);
-        tunnel_1_reverse->length = new_length;
-        tunnel_1_reverse->valve = tunnel_2.valve;
-        // relink valve connected to tunnel 2 to valve connected to tunnel 1
-        auto tunnel_2_reverse = tunnel_2.valve->get_tunnel_to(valve);
-        tunnel_2_reverse->length = new_length;
-        tunnel_2_reverse->valve = tunnel_1.valve;
-        // mark this valve to be deleted
-        name_lookup.erase(valve->name);
-        valves.erase(valves.begin() + key);
-    }
-    // renumber the remaining valves
-    for (Key new_key = 0; new_key < valves.size(); ++new_key) {
-        Valve *valve = valves[new_key].get();
-        valve->key = new_key;
-        name_lookup[valve->name] = new_key;
-    }
-}
+// Shortest distances between valves, in one block with each row padded to
+// 16 bytes. Distances saturate at FAR, which is longer than any time limit.
+class DistanceMatrix {
+    std::size_t stride;
+    std::vector<std::uint8_t> distances;
 
-using DistanceMap = std::vector<std::vector<int>>;
-
-template <typename T>
-DistanceMap floyd_warshall(const T &valves) {
-    // follows https://en.wikipedia.org/wiki/Floyd%E2%80%93Warshall_algorithm
-    DistanceMap dists(valves.size());
-    for (Key u = 0; u < valves.size(); ++u) {
-        // initialize all distances to a very large number (but not too big, as
-        // we don't want to overflow)
-        dists[u].resize(valves.size(), std::numeric_limits<int>::max() / 10);
-        dists[u][u] = 0;
-        for (const Tunnel &tunnel : valves[u]->tunnels) {
-            Key v = tunnel->key;
-            dists[u][v] = tunnel.length;
-        }
-    }
-    // standard implementation
-    for (Key k = 0; k < valves.size(); ++k) {
-        for (Key i = 0; i < valves.size(); ++i) {
-            for (Key j = 0; j < valves.size(); ++j) {
-                if (dists[i][j] > dists[i][k] + dists[k][j]) {
-                    dists[i][j] = dists[i][k] + dists[k][j];
-                }
-            }
-        }
-    }
-    return dists;
-}
+  public:
+    static constexpr int FAR = std::numeric_limits<std::uint8_t>::max();
 
-struct SolverInfo {
-    const Graph &graph;
-    const DistanceMap &dists;
-    const Key &initial_pos;
+    explicit DistanceMatrix(std::size_t size)
+        : stride((size + 15) / 16 * 16), distances(size * stride, FAR) {}
 
-    SolverInfo(const Graph &graph, const DistanceMap &dists)
-        : graph(graph), dists(dists), initial_pos(graph.name_lookup.at("AA")) {}
+    std::uint8_t *operator[](Key from) {
+        return distances.data() + from * stride;
+    }
+    const std::uint8_t *operator[](Key from) const {
+        return distances.data() + from * stride;
+    }
 };
 
-class DFSSolver {
-    const SolverInfo &info;
-    Key my_pos;
-    int my_remaining_time;
-    Key elephant_pos;
-    int elephant_remaining_time;
+// The valves that the solvers care about: AA and the ones with nonzero flow,
+// renumbered in input order, and the distances between them.
+struct SolverInfo {
+    std::vector<int> flow_rates{};
+    DistanceMatrix dists;
+    Key initial_pos{};
 
-  public:
-    DFSSolver(const SolverInfo &info, int my_time, int elephant_time = 0)
-        : info(info), my_pos(info.initial_pos), my_remaining_time(my_time),
-          elephant_pos(info.initial_pos),
-          elephant_remaining_time(elephant_time) {}
+    explicit SolverInfo(const Graph &graph);
 
-    int solve(unsigned int visited_valves = 0, int depth = 0);
+    std::size_t num_valves() const { return flow_rates.size(); }
 };
 
-int DFSSolver::solve(unsigned int visited_valves, int depth) {
-    // move the one with more remaining time
-    const bool move_me = my_remaining_time >= elephant_remaining_time;
-    Key &current_pos = move_me ? my_pos : elephant_pos;
-    int &remaining_time = move_me ? my_remaining_time : elephant_remaining_time;
-    if constexpr (aoc::DEBUG) {
-        std::cerr << std::string(depth * 2, ' ') << "moving "
-                  << (move_me ? "me" : "elephant") << " to "
-                  << info.graph.valves[current_pos]->name << " at time "
-                  << (30 - remaining_time) << "\n";
-    }
-    const auto &distances = info.dists[current_pos];
-    Key prev_pos = current_pos;
-    int best_total = 0;
-    for (Key key = 0, mask = 1; key < info.graph.valves.size();
-         ++key, mask <<= 1) {
-        Valve *valve = info.graph.valves[key].get();
-        if (visited_valves & mask || valve->flow_rate == 0) {
-            // skip valves we've already opened
-            continue;
-        }
-        // calculate total future value for an unopened valve, given the
-        // distance to the valve and the remaining time
-        int distance = distances[key];
-        assert(distance >= 0);
-        // deduct the travel time plus the minute it takes to open the valve
-        int future_value = (remaining_time - (distance + 1)) * valve->flow_rate;
-        if (future_value <= 0) {
-            continue;
-        }
-        // recurse from the new state
-        current_pos = key;
-        remaining_time -= distance + 1;
-        int total = future_value + solve(visited_valves | mask, depth + 1);
-        remaining_time += distance + 1;
-        current_pos = prev_pos;
-        if (total > best_total) {
-            best_total = total;
+SolverInfo::SolverInfo(const Graph &graph)
+    : dists(std::ranges::count_if(graph.valves, [](const auto &valve) {
+          return valve->flow_rate > 0 || valve->name == "AA";
+      })) {
+    // graph key -> key here, for the valves that have one
+    std::vector<int> new_keys(graph.valves.size(), -1);
+    for (const auto &valve : graph.valves) {
+        if (valve->flow_rate > 0 || valve->name == "AA") {
+            new_keys[valve->key] = flow_rates.size();
+            flow_rates.push_back(valve->flow_rate);
         }
     }
-    if constexpr (aoc::DEBUG) {
-        if (best_total > 0) {
-            std::cerr << std::string(depth * 2, ' ')
-                      << "best total pressure: " << best_total << "\n";
+    initial_pos = new_keys[graph.key_of("AA")];
+    // every tunnel takes a minute, so a BFS from each valve does it
+    aoc::GraphSearch search;
+    for (const auto &source : graph.valves) {
+        const int from = new_keys[source->key];
+        if (from < 0) {
+            continue;
         }
+        search.bfs(
+            graph.valves.size(), {source->key},
+            [&](std::size_t node, auto push) {
+                for (const Tunnel &tunnel : graph.valves[node]->tunnels) {
+                    push(tunnel->key);
+                }
+            },
+            [&](std::size_t node, int distance) {
+                if (new_keys[node] >= 0) {
+                    dists[from][new_keys[node]] =
+                        std::min(distance, DistanceMatrix::FAR);
+                }
+                return false;
+            });
     }
-    return best_total;
 }
 
+// a set of valves, by key
+using ValveSet = std::uint64_t;
+constexpr std::size_t MAX_VALVES = 64;
+// the most flow that fits in a State2
+constexpr int MAX_TOTAL_FLOW = std::numeric_limits<std::uint16_t>::max();
+
+// Both fit in a byte: there are at most MAX_VALVES valves, and no one travels
+// for longer than the time limit.
 struct Entity {
-    Key pos;
-    int travel_time;
+    std::uint8_t pos{};
+    std::uint8_t travel_time{};
 
-    Entity() : pos(-1), travel_time(-1) {}
+    Entity() = default;
 
     Entity(Key pos, int travel_time) : pos(pos), travel_time(travel_time) {}
 
@@ -266,199 +272,6 @@ struct Entity {
     }
 };
 
-struct State {
-    const Entity entity_1;
-    const Entity entity_2;
-    const int total_flow;
-    const unsigned int visited_valves;
-    bool good = true;
-
-    State(const SolverInfo &info, int total_time, bool use_entity_2)
-        : entity_1(info.initial_pos, 0),
-          entity_2(info.initial_pos, use_entity_2 ? 0 : total_time),
-          total_flow(0), visited_valves(0) {}
-    State(int total_flow, unsigned int visited_valves, Entity entity_1,
-          Entity entity_2)
-        : entity_1(entity_1), entity_2(entity_2), total_flow(total_flow),
-          visited_valves(visited_valves) {}
-
-    State wait() const {
-        assert(entity_1.travel_time > 0);
-        assert(entity_2.travel_time > 0);
-        return State(total_flow, visited_valves, entity_1.travel(),
-                     entity_2.travel());
-    }
-    template <int index>
-    State move_one(const Entity &moved_entity, int future_value) const {
-        static_assert(index == 1 || index == 2, "index must be 1 or 2");
-        if constexpr (index == 1) {
-            assert(entity_1.travel_time == 0 && entity_2.travel_time > 0);
-        } else {
-            assert(entity_1.travel_time > 0 && entity_2.travel_time == 0);
-        }
-        assert(future_value > 0);
-        if constexpr (index == 1) {
-            return State(total_flow + future_value,
-                         visited_valves | (1 << moved_entity.pos), moved_entity,
-                         entity_2.travel());
-        } else {
-            return State(total_flow + future_value,
-                         visited_valves | (1 << moved_entity.pos),
-                         entity_1.travel(), moved_entity);
-        }
-    }
-
-    State move_both(const Entity &new_entity_1, const Entity &new_entity_2,
-                    int future_value) const {
-        assert(entity_1.travel_time == 0 && entity_2.travel_time == 0);
-        assert(future_value > 0);
-        return State(total_flow + future_value,
-                     visited_valves | (1 << new_entity_1.pos) |
-                         (1 << new_entity_2.pos),
-                     new_entity_1, new_entity_2);
-    }
-
-    int flow_upper_bound(const SolverInfo &info, int remaining_time) {
-        int max_flow = total_flow;
-        const auto &distances_1 = info.dists[entity_1.pos];
-        const auto &distances_2 = info.dists[entity_2.pos];
-        for (Key key = 0; key < info.graph.valves.size(); ++key) {
-            if (visited_valves & (1 << key)) {
-                continue;
-            }
-            int distance_1 = distances_1[key] + entity_1.travel_time;
-            int distance_2 = distances_2[key] + entity_2.travel_time;
-            int future_value =
-                (remaining_time - (std::min(distance_1, distance_2) + 1)) *
-                info.graph.valves[key]->flow_rate;
-            if (future_value <= 0) {
-                continue;
-            }
-            max_flow += future_value;
-        }
-        return max_flow;
-    }
-};
-
-int solve_bfs(const SolverInfo &info, int total_time,
-              bool use_entity_2 = false) {
-    std::vector<State> curr_queue{{State(info, total_time, use_entity_2)}};
-    std::vector<State> next_queue{};
-
-    int best_total = 0;
-    for (int remaining_time = total_time; remaining_time > 0;
-         --remaining_time) {
-        int state_count = 0;
-        int best_actual_flow = 0;
-        for (auto it = curr_queue.begin(); it != curr_queue.end(); ++it) {
-            const State &state = *it;
-            if (!state.good) {
-                continue;
-            }
-            if (state.total_flow > best_total) {
-                best_total = state.total_flow;
-            }
-            if (state.entity_1.travel_time > 0 &&
-                state.entity_2.travel_time > 0) {
-                next_queue.push_back(state.wait());
-                if (next_queue.back().total_flow > best_actual_flow) {
-                    best_actual_flow = next_queue.back().total_flow;
-                }
-                continue;
-            }
-            ++state_count;
-            const auto &distances_1 = info.dists[state.entity_1.pos];
-            const auto &distances_2 = info.dists[state.entity_2.pos];
-            for (Key key_a = 0; key_a < info.graph.valves.size(); ++key_a) {
-                int flow_rate = info.graph.valves[key_a]->flow_rate;
-                if (state.visited_valves & (1 << key_a) || flow_rate == 0) {
-                    // skip valves we've already opened
-                    continue;
-                }
-                // calculate total future value for an unopened valve, given the
-                // distance to the valve and the remaining time
-                int distance_a;
-                if (state.entity_1.travel_time == 0) {
-                    distance_a = distances_1[key_a];
-                } else {
-                    distance_a = distances_2[key_a];
-                }
-                // deduct the travel time plus the minute it takes to open the
-                // valve
-                int future_value_a =
-                    (remaining_time - (distance_a + 1)) * flow_rate;
-                if (future_value_a <= 0) {
-                    continue;
-                }
-                if (state.entity_2.travel_time > 0) {
-                    // move entity 1
-                    next_queue.push_back(state.move_one<1>(
-                        Entity(key_a, distance_a), future_value_a));
-                    if (next_queue.back().total_flow > best_actual_flow) {
-                        best_actual_flow = next_queue.back().total_flow;
-                    }
-                    continue;
-                }
-                if (state.entity_1.travel_time > 0) {
-                    // move entity 2
-                    next_queue.push_back(state.move_one<2>(
-                        Entity(key_a, distance_a), future_value_a));
-                    if (next_queue.back().total_flow > best_actual_flow) {
-                        best_actual_flow = next_queue.back().total_flow;
-                    }
-                    continue;
-                }
-                // loop over possible destinations for entity 2
-                assert(state.entity_1.travel_time == 0 &&
-                       state.entity_2.travel_time == 0);
-                for (Key key_b = 0; key_b < info.graph.valves.size(); ++key_b) {
-                    if (key_b == key_a) {
-                        continue;
-                    }
-                    flow_rate = info.graph.valves[key_b]->flow_rate;
-                    if (state.visited_valves & (1 << key_b) || flow_rate == 0) {
-                        // skip valves we've already opened
-                        continue;
-                    }
-                    // calculate total future value for an unopened valve, given
-                    // the distance to the valve and the remaining time
-                    int distance_b = distances_2[key_b];
-                    // deduct the travel time plus the minute it takes to open
-                    // the valve
-                    int future_value_b =
-                        (remaining_time - (distance_b + 1)) * flow_rate;
-                    if (future_value_b <= 0) {
-                        continue;
-                    }
-                    next_queue.push_back(state.move_both(
-                        Entity(key_a, distance_a), Entity(key_b, distance_b),
-                        future_value_a + future_value_b));
-                    if (next_queue.back().total_flow > best_actual_flow) {
-                        best_actual_flow = next_queue.back().total_flow;
-                    }
-                }
-            }
-        }
-        int reject_count = 0;
-        for (auto it = next_queue.begin(); it != next_queue.end(); ++it) {
-            if (it->flow_upper_bound(info, remaining_time - 1) <
-                best_actual_flow) {
-                it->good = false;
-                ++reject_count;
-            }
-        }
-        if constexpr (aoc::DEBUG) {
-            std::cerr << "remaining time = " << total_time - remaining_time + 1
-                      << ": " << state_count << " states, "
-                      << next_queue.size() - reject_count << " branches ("
-                      << reject_count << " rejected)\n";
-        }
-        curr_queue.clear();
-        std::swap(curr_queue, next_queue);
-    }
-    return best_total;
-}
-
 namespace detail {
 template <typename T, std::size_t... Is>
 constexpr std::array<T, sizeof...(Is)>
@@ -473,57 +286,30 @@ constexpr std::array<T, N> create_array(const T &value) {
     return detail::create_array(value, std::make_index_sequence<N>());
 }
 
+// Ordered largest first, so there's no padding between the fields: with 2
+// entities this is 16 bytes, and the search's entries 24.
 template <std::size_t N>
 struct State2 {
     static constexpr std::size_t size = N;
-    const std::array<Entity, N> entities;
-    const int total_flow;
-    const unsigned int visited_valves;
-    bool good = true;
-
-    explicit State2(const SolverInfo &info)
-        : entities(create_array<N>(Entity(info.initial_pos, 0))), total_flow(0),
-          visited_valves(0) {}
-
-    State2(int total_flow, unsigned int visited_valves,
-           const std::array<Entity, N> &new_entities)
-        : entities(new_entities), total_flow(total_flow),
-          visited_valves(visited_valves) {}
-
-    State2(int total_flow, unsigned int visited_valves,
-           std::convertible_to<Entity> auto &&...new_entities)
-        : entities{new_entities...}, total_flow(total_flow),
-          visited_valves(visited_valves) {}
-
-    template <std::size_t... Is>
-    State2 move_some(int future_value,
-                     std::convertible_to<const Entity> auto &&...Es) const {
-        std::array<Entity, N> new_entities;
-        // std::transform(entities.cbegin(), entities.cend(),
-        // new_entities.begin(),
-        //                [](const Entity &entity) { return entity.travel(); });
-        unsigned int new_valves = visited_valves;
-        std::initializer_list<std::size_t> indices{Is...};
-        std::initializer_list<const Entity> moved_entities{Es...};
-        auto i_it = indices.begin();
-        auto moved_it = moved_entities.begin();
-        for (std::size_t i = 0; i < N; ++i) {
-            if (i_it != indices.end() && i == *i_it) {
-                new_entities[i] = *moved_it;
-                new_valves |= 1 << moved_it->pos;
-                ++i_it;
-                ++moved_it;
-            } else {
-                new_entities[i] = entities[i].travel();
-            }
-        }
-        return State2(total_flow + future_value, new_valves, new_entities);
-    }
+    ValveSet visited_valves;
+    // see MAX_TOTAL_FLOW
+    std::uint16_t total_flow;
+    std::uint8_t remaining_time;
+    std::array<Entity, N> entities;
+
+    State2(const SolverInfo &info, int total_time)
+        : visited_valves(0), total_flow(0), remaining_time(total_time),
+          entities(create_array<N>(Entity(info.initial_pos, 0))) {}
+
+    State2(int total_flow, ValveSet visited_valves,
+           const std::array<Entity, N> &new_entities, int remaining_time)
+        : visited_valves(visited_valves), total_flow(total_flow),
+          remaining_time(remaining_time), entities(new_entities) {}
 
     int flow_upper_bound(const SolverInfo &info, int remaining_time) const {
         int max_flow = total_flow;
-        for (Key key = 0; key < info.graph.valves.size(); ++key) {
-            if (visited_valves & (1 << key)) {
+        for (Key key = 0; key < info.num_valves(); ++key) {
+            if (visited_valves & ValveSet{1} << key) {
                 continue;
             }
             int min_distance = std::numeric_limits<int>::max();
@@ -533,7 +319,7 @@ struct State2 {
                              info.dists[entity.pos][key] + entity.travel_time);
             }
             int future_value = (remaining_time - (min_distance + 1)) *
-                               info.graph.valves[key]->flow_rate;
+                               info.flow_rates[key];
             if (future_value <= 0) {
                 continue;
             }
@@ -543,141 +329,20 @@ struct State2 {
     }
 };
 
-template <bool use_entity_2>
-int solve_bfs_2(const SolverInfo &info, int total_time) {
-    using state_t = std::conditional_t<use_entity_2, State2<2>, State2<1>>;
-    std::vector<state_t> curr_queue{{state_t(info)}};
-    std::vector<state_t> next_queue{};
-
-    int best_total = 0;
-    for (int remaining_time = total_time; remaining_time > 0;
-         --remaining_time) {
-        int state_count = 0;
-        int best_actual_flow = 0;
-        for (auto it = curr_queue.begin(); it != curr_queue.end(); ++it) {
-            const state_t &state = *it;
-            if (!state.good) {
-                continue;
-            }
-            if (state.total_flow > best_total) {
-                best_total = state.total_flow;
-            }
-            if (std::ranges::all_of(state.entities, [](const Entity &entity) {
-                    return entity.travel_time > 0;
-                })) {
-                next_queue.push_back(state.template move_some<>(0));
-                if (next_queue.back().total_flow > best_actual_flow) {
-                    best_actual_flow = next_queue.back().total_flow;
-                }
-                continue;
-            }
-            ++state_count;
-            const auto &distances_1 = info.dists[state.entities.at(0).pos];
-            // const auto &distances_2 = info.dists[state.entities.at(1).pos];
-            for (Key key_a = 0; key_a < info.graph.valves.size(); ++key_a) {
-                int flow_rate = info.graph.valves[key_a]->flow_rate;
-                if (state.visited_valves & (1 << key_a) || flow_rate == 0) {
-                    // skip valves we've already opened
-                    continue;
-                }
-                // calculate total future value for an unopened valve, given
-                // the distance to the valve and the remaining time
-                int distance_a = -1;
-                if (!use_entity_2 || state.entities[0].travel_time == 0) {
-                    distance_a = distances_1[key_a];
-                } else {
-                    distance_a = info.dists[state.entities.at(1).pos][key_a];
-                }
-                // deduct the travel time plus the minute it takes to open
-                // the valve
-                int future_value_a =
-                    (remaining_time - (distance_a + 1)) * flow_rate;
-                if (future_value_a <= 0) {
-                    continue;
-                }
-                if (!use_entity_2 || state.entities[1].travel_time > 0) {
-                    // move entity 1
-                    next_queue.push_back(state.template move_some<0>(
-                        future_value_a, Entity(key_a, distance_a)));
-                    if (next_queue.back().total_flow > best_actual_flow) {
-                        best_actual_flow = next_queue.back().total_flow;
-                    }
-                    continue;
-                }
-                if (state.entities[0].travel_time > 0) {
-                    // move entity 2
-                    next_queue.push_back(state.template move_some<1>(
-                        future_value_a, Entity(key_a, distance_a)));
-                    if (next_queue.back().total_flow > best_actual_flow) {
-                        best_actual_flow = next_queue.back().total_flow;
-                    }
-                    continue;
-                }
-                // loop over possible destinations for entity 2
-                assert(state.entities[0].travel_time == 0 &&
-                       state.entities[1].travel_time == 0);
-                for (Key key_b = 0; key_b < info.graph.valves.size(); ++key_b) {
-                    if (key_b == key_a) {
-                        continue;
-                    }
-                    flow_rate = info.graph.valves[key_b]->flow_rate;
-                    if (state.visited_valves & (1 << key_b) || flow_rate == 0) {
-                        // skip valves we've already opened
-                        continue;
-                    }
-                    // calculate total future value for an unopened valve,
-                    // given the distance to the valve and the remaining
-                    // time
-                    int distance_b =
-                        info.dists[state.entities.at(1).pos][key_b];
-                    // deduct the travel time plus the minute it takes to
-                    // open the valve
-                    int future_value_b =
-                        (remaining_time - (distance_b + 1)) * flow_rate;
-                    if (future_value_b <= 0) {
-                        continue;
-                    }
-                    next_queue.push_back(state.template move_some<0, 1>(
-                        future_value_a + future_value_b,
-                        Entity(key_a, distance_a), Entity(key_b, distance_b)));
-                    if (next_queue.back().total_flow > best_actual_flow) {
-                        best_actual_flow = next_queue.back().total_flow;
-                    }
-                }
-            }
-        }
-        int reject_count = 0;
-        for (auto it = next_queue.begin(); it != next_queue.end(); ++it) {
-            if (it->flow_upper_bound(info, remaining_time - 1) <
-                best_actual_flow) {
-                it->good = false;
-                ++reject_count;
-            }
-        }
-        if constexpr (aoc::DEBUG) {
-            std::cerr << "remaining time = " << total_time - remaining_time + 1
-                      << ": " << state_count << " states, "
-                      << next_queue.size() - reject_count << " branches ("
-                      << reject_count << " rejected)\n";
-        }
-        curr_queue.clear();
-        std::swap(curr_queue, next_queue);
-    }
-    return best_total;
-}
+static_assert(sizeof(State2<2>) == 16);
 
-template <std::size_t N, std::size_t M>
-void produce_states(const SolverInfo &, std::vector<State2<N>> &next_queue,
-                    const int &, int new_flow, unsigned int new_visited,
+template <std::size_t N, std::size_t M, typename Push>
+void produce_states(const SolverInfo &, Push &push, const int &remaining_time,
+                    int new_flow, ValveSet new_visited,
                     const std::array<Entity, M> new_entities) {
     static_assert(M == N);
-    next_queue.emplace_back(new_flow, new_visited, new_entities);
+    push(State2<N>(new_flow, new_visited, new_entities, remaining_time - 1));
 }
 
-template <std::size_t N, std::size_t M>
-void produce_states(const SolverInfo &info, std::vector<State2<N>> &next_queue,
+template <std::size_t N, std::size_t M, typename Push>
+void produce_states(const SolverInfo &info, Push &push,
                     const int &remaining_time, int new_flow,
-                    unsigned int new_visited,
+                    ValveSet new_visited,
                     const std::array<Entity, M> &prev_entities,
                     const Entity &curr_entity,
                     std::convertible_to<const Entity &> auto &&...rest) {
@@ -686,14 +351,14 @@ void produce_states(const SolverInfo &info, std::vector<State2<N>> &next_queue,
         std::array<Entity, M + 1> new_entities;
         std::ranges::copy(prev_entities, new_entities.begin());
         std::get<M>(new_entities) = curr_entity.travel();
-        produce_states<N, M + 1>(info, next_queue, remaining_time, new_flow,
+        produce_states<N, M + 1>(info, push, remaining_time, new_flow,
                                  new_visited, new_entities, rest...);
     } else {
-        const auto &distances = info.dists[curr_entity.pos];
-        for (Key key = 0, mask = 1; key < info.graph.valves.size();
-             ++key, mask <<= 1) {
+        const std::uint8_t *distances = info.dists[curr_entity.pos];
+        ValveSet mask = 1;
+        for (Key key = 0; key < info.num_valves(); ++key, mask <<= 1) {
 
-            int flow_rate = info.graph.valves[key]->flow_rate;
+            int flow_rate = info.flow_rates[key];
             if (new_visited & mask || flow_rate == 0) {
                 // skip valves we've already opened
                 continue;
@@ -712,100 +377,284 @@ void produce_states(const SolverInfo &info, std::vector<State2<N>> &next_queue,
             std::array<Entity, M + 1> new_entities;
             std::ranges::copy(prev_entities, new_entities.begin());
             std::get<M>(new_entities) = Entity(key, distance);
-            produce_states<N, M + 1>(info, next_queue, remaining_time,
+            produce_states<N, M + 1>(info, push, remaining_time,
                                      new_flow + future_value,
                                      new_visited | mask, new_entities, rest...);
         }
+        if constexpr (N > 1) {
+            // Stop for good, leaving the remaining valves to the others: an
+            // entity may have nowhere worth going while another is still
+            // travelling, or its best valve may be closer to someone else.
+            std::array<Entity, M + 1> new_entities;
+            std::ranges::copy(prev_entities, new_entities.begin());
+            std::get<M>(new_entities) = Entity(curr_entity.pos, remaining_time);
+            produce_states<N, M + 1>(info, push, remaining_time, new_flow,
+                                     new_visited, new_entities, rest...);
+        }
     }
 }
 
+// opening valves with N entities, as a problem for aoc::BranchAndBound
 template <std::size_t N>
-void produce_states(const SolverInfo &info, std::vector<State2<N>> &next_queue,
-                    const int &remaining_time, const State2<N> &state) {
-    [&]<std::size_t... I>(std::index_sequence<I...>) {
-        produce_states<N>(info, next_queue, remaining_time, state.total_flow,
-                          state.visited_valves, std::array<Entity, 0>{},
-                          std::get<I>(state.entities)...);
-    }
-    (std::make_index_sequence<N>{});
-}
+class ValveProblem {
+    const SolverInfo &info;
 
-template <int N>
-int solve_bfs_3(const SolverInfo &info, int total_time) {
-    using state_t = State2<N>;
-    std::vector<state_t> curr_queue{{state_t(info)}};
-    std::vector<state_t> next_queue{};
-
-    int best_total = 0;
-    for (int remaining_time = total_time; remaining_time > 0;
-         --remaining_time) {
-        int best_actual_flow = 0;
-        std::size_t next_i = 0;
-        for (auto it = curr_queue.begin(); it != curr_queue.end(); ++it) {
-            const state_t &state = *it;
-            if (!state.good) {
-                continue;
-            }
-            if (state.total_flow > best_total) {
-                best_total = state.total_flow;
-            }
-            produce_states(info, next_queue, remaining_time, state);
-            for (; next_i < next_queue.size(); ++next_i) {
-                if (next_queue[next_i].total_flow > best_actual_flow) {
-                    best_actual_flow = next_queue[next_i].total_flow;
-                }
+  public:
+    using state_type = State2<N>;
+
+    explicit ValveProblem(const SolverInfo &info) : info(info) {}
+
+    // each valve's flow is counted in full as soon as it's chosen
+    int value(const State2<N> &state) const { return state.total_flow; }
+    int bound(const State2<N> &state) const {
+        return state.flow_upper_bound(info, state.remaining_time);
+    }
+
+    // Everything but the flow, with the entities sorted, since they're
+    // interchangeable: swapping the two entities gives the same successors.
+    // The time and entities take 6 bits per field, which fits up to 4.
+    aoc::WideKey key(const State2<N> &state) const
+        requires(N <= 4)
+    {
+        std::array<std::uint64_t, N> entities;
+        for (std::size_t i = 0; i < N; ++i) {
+            const Entity &entity = state.entities[i];
+            if constexpr (!aoc::FAST) {
+                assert(entity.travel_time < (1 << 6));
             }
+            entities[i] = entity.pos << 6 | entity.travel_time;
         }
-        int reject_count = 0;
-        for (auto it = next_queue.begin(); it != next_queue.end(); ++it) {
-            if (it->flow_upper_bound(info, remaining_time - 1) <
-                best_actual_flow) {
-                it->good = false;
-                ++reject_count;
-            }
+        std::ranges::sort(entities);
+        std::uint64_t high = state.remaining_time;
+        for (std::uint64_t entity : entities) {
+            high = high << 12 | entity;
+        }
+        return {high, state.visited_valves};
+    }
+
+    template <typename Push>
+    void expand(const State2<N> &state, Push push) const {
+        if (state.remaining_time == 0) {
+            return;
         }
-        if constexpr (aoc::DEBUG) {
-            std::cerr << "remaining time = " << total_time - remaining_time + 1
-                      << ": " << next_queue.size() - reject_count
-                      << " branches (" << reject_count << " rejected)\n";
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            produce_states<N>(info, push, state.remaining_time,
+                              state.total_flow, state.visited_valves,
+                              std::array<Entity, 0>{},
+                              std::get<I>(state.entities)...);
         }
-        curr_queue.clear();
-        std::swap(curr_queue, next_queue);
+        (std::make_index_sequence<N>{});
+    }
+};
+
+template <std::size_t N>
+int solve_search(const SolverInfo &info, int total_time) {
+    AOC_TIMER("day16.solve_search");
+    if (info.num_valves() > MAX_VALVES) {
+        throw std::invalid_argument("too many valves to search");
+    }
+    int max_flow = 0;
+    for (int flow_rate : info.flow_rates) {
+        max_flow += flow_rate * total_time;
+    }
+    if (max_flow > MAX_TOTAL_FLOW) {
+        throw std::invalid_argument("flow rates too high to search");
     }
-    return best_total;
+    ValveProblem<N> problem{info};
+    // depth first finds good states early, so the bound prunes well
+    aoc::BranchAndBound search{
+        problem, aoc::SearchOptions::from_env({aoc::SearchStrategy::dfs})};
+    const int best = search.run(State2<N>(info, total_time));
+    AOC_COUNTER("day16.states_expanded", search.stats().expanded);
+    AOC_COUNTER("day16.states_generated", search.stats().generated);
+    AOC_COUNTER("day16.states_pruned", search.stats().pruned_bound);
+    AOC_COUNTER("day16.states_duplicate", search.stats().pruned_duplicate);
+    if constexpr (aoc::DEBUG) {
+        std::cerr << N << " entities, " << total_time
+                  << " minutes: " << search.stats() << "\n";
+    }
+    return best;
 }
 
-} // namespace aoc::day16
+// The best total flow a single entity can get by opening exactly each set of
+// valves, filled by one exhaustive search. Entities never open the same valve
+// twice, so the best plan for several of them is the best combination of
+// disjoint sets, which avoids searching their joint states at all.
+class SubsetTable {
+    const SolverInfo &info;
+    // the valves with nonzero flow; bit i of a set is flow_valves[i]
+    std::vector<Key> flow_valves{};
+    // indexed by set, -1 where no path opens exactly that set
+    std::vector<int> best{};
+    // the sets with an entry in best, in the order they were found
+    std::vector<std::uint32_t> reached{};
+    // Many orders of opening the same valves end up in the same place at the
+    // same time, and only the one with the most flow needs to go on. Keyed by
+    // the set, position and remaining time.
+    std::unordered_map<std::uint64_t, int> visited{};
+
+    void fill(Key pos, int remaining_time, std::uint32_t opened, int flow);
+
+  public:
+    // the table takes 4 bytes per subset of these
+    static constexpr int MAX_VALVES = 26;
+    // Solving with two entities keeps a second table-sized array alive, so
+    // only pick this engine by default while that stays small (about 130 MB
+    // at 24 valves, and 4 times as much at 26).
+    static constexpr int DEFAULT_MAX_VALVES = 24;
+
+    SubsetTable(const SolverInfo &info, int total_time);
+
+    std::size_t num_sets() const { return reached.size(); }
+    int solve(int num_entities) const;
+};
+
+SubsetTable::SubsetTable(const SolverInfo &info, int total_time) : info(info) {
+    AOC_TIMER("day16.subsets_fill");
+    for (Key key = 0; key < info.num_valves(); ++key) {
+        if (info.flow_rates[key] > 0) {
+            flow_valves.push_back(key);
+        }
+    }
+    if (flow_valves.size() > MAX_VALVES) {
+        throw std::invalid_argument("too many valves for a subset table");
+    }
+    best.resize(std::size_t{1} << flow_valves.size(), -1);
+    fill(info.initial_pos, total_time, 0, 0);
+    visited = {};
+}
 
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void SubsetTable::fill(Key pos, int remaining_time, std::uint32_t opened,
+                       int flow) {
+    const std::uint64_t key = opened | std::uint64_t{pos} << 32 |
+                              std::uint64_t(remaining_time) << 40;
+    auto [it, inserted] = visited.try_emplace(key, flow);
+    if (!inserted) {
+        if (it->second >= flow) {
+            return;
+        }
+        it->second = flow;
+    }
+    if (best[opened] < 0) {
+        reached.push_back(opened);
+    }
+    best[opened] = std::max(best[opened], flow);
+    for (std::size_t i = 0; i < flow_valves.size(); ++i) {
+        const std::uint32_t mask = std::uint32_t{1} << i;
+        if (opened & mask) {
+            continue;
+        }
+        const Key next = flow_valves[i];
+        // travel there, then spend a minute opening it
+        const int time_left = remaining_time - info.dists[pos][next] - 1;
+        if (time_left <= 0) {
+            continue;
+        }
+        fill(next, time_left, opened | mask,
+             flow + time_left * info.flow_rates[next]);
+    }
+}
 
-    using namespace aoc::day16;
+int SubsetTable::solve(int num_entities) const {
+    AOC_TIMER("day16.subsets_combine");
+    assert(num_entities >= 1);
+    if (num_entities == 1) {
+        return *std::ranges::max_element(best);
+    }
+    // closure[set]: the best flow from opening any subset of set
+    std::vector<int> closure(best.size());
+    std::ranges::transform(best, closure.begin(),
+                           [](int flow) { return std::max(flow, 0); });
+    for (std::size_t bit = 1; bit < closure.size(); bit <<= 1) {
+        // each block of 2 * bit sets: the upper half are the lower half
+        // plus this bit (written out so it vectorizes)
+        for (std::size_t base = 0; base < closure.size(); base += 2 * bit) {
+            for (std::size_t set = base; set < base + bit; ++set) {
+                closure[set + bit] =
+                    std::max(closure[set + bit], closure[set]);
+            }
+        }
+    }
+    const std::uint32_t all = best.size() - 1;
+    // add entities one at a time, each opening a set disjoint from what the
+    // others opened; only the last one needs just the full set
+    for (int entity = 2; entity < num_entities; ++entity) {
+        std::vector<int> combined = closure;
+        for (std::uint32_t opened : reached) {
+            const std::uint32_t others = all ^ opened;
+            // every superset of opened, by the subsets of the rest
+            for (std::uint32_t rest = others;; rest = (rest - 1) & others) {
+                int &entry = combined[opened | rest];
+                entry = std::max(entry, best[opened] + closure[rest]);
+                if (rest == 0) {
+                    break;
+                }
+            }
+        }
+        closure = std::move(combined);
+    }
+    int result = 0;
+    for (std::uint32_t opened : reached) {
+        result = std::max(result, best[opened] + closure[all ^ opened]);
+    }
+    return result;
+}
+
+enum class Engine { search, subsets };
+
+// AOC_DAY16_ENGINE picks the solver. The default is the subset table, unless
+// there are enough valves that its tables get too big.
+Engine engine_from_env(const SolverInfo &info) {
+    const char *value = std::getenv("AOC_DAY16_ENGINE");
+    if (value == nullptr) {
+        const auto num_flow_valves = std::ranges::count_if(
+            info.flow_rates, [](int flow_rate) { return flow_rate > 0; });
+        return num_flow_valves <= SubsetTable::DEFAULT_MAX_VALVES
+                   ? Engine::subsets
+                   : Engine::search;
+    }
+    if (std::string_view{value} == "subsets") {
+        return Engine::subsets;
+    }
+    if (std::string_view{value} == "search") {
+        return Engine::search;
+    }
+    throw std::invalid_argument("unknown AOC_DAY16_ENGINE: " +
+                                std::string{value});
+}
+
+void solve(std::string_view text, std::ostream &out) {
     Graph graph{};
-    // read file line-by-line
-    std::string line;
-    while (std::getline(infile, line)) {
-        graph.read_line(line);
-    }
-    graph.simplify();
-    // graph.output_graphviz(std::cout);
-
-    auto dists = floyd_warshall(graph.valves);
-    SolverInfo info{graph, dists};
-    int total = 0;
-    constexpr int N = 1;
-    for (int i = 0; i < N; ++i) {
-        // DFSSolver solver_1{info, 30};
-        // total += solver_1.solve();
-        // total += solve_bfs(info, 30);
-        total += solve_bfs_3<1>(info, 30);
-    }
-    std::cout << total / N << "\n";
-
-    // DFSSolver solver_2{info, 26, 26};
-    // std::cout << solver_2.solve() << "\n";
-    // std::cout << solve_bfs(info, 26, true) << "\n";
-    std::cout << solve_bfs_3<2>(info, 26) << "\n";
-
-    return 0;
+    if (auto cache = aoc::InputCache::load(text, 16, Graph::CACHE_VERSION)) {
+        graph.read_cache(*cache);
+    } else {
+        for (std::string_view line : aoc::lines(text)) {
+            graph.read_line(line);
+        }
+        graph.write_cache(text);
+    }
+    aoc::mark_parsed();
+    // graph.output_graphviz(out);
+
+    const SolverInfo info{graph};
+    if (engine_from_env(info) == Engine::search) {
+        out << solve_search<1>(info, 30) << "\n";
+        out << solve_search<2>(info, 26) << "\n";
+        return;
+    }
+    AOC_TIMER("day16.solve_subsets");
+    // the two parts have different time limits, so they need their own
+    // tables; only keep one alive at a time
+    {
+        const SubsetTable alone{info, 30};
+        AOC_COUNTER("day16.subsets_reached", alone.num_sets());
+        out << alone.solve(1) << "\n";
+    }
+    const SubsetTable with_elephant{info, 26};
+    AOC_COUNTER("day16.subsets_reached", with_elephant.num_sets());
+    out << with_elephant.solve(2) << "\n";
 }
+
+const SolutionRegistrar registrar{16, solve};
+
+} // namespace aoc::day16
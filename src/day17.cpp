@@ -9,10 +9,11 @@
 #include <algorithm>   // for transform, for_each, max
 #include <array>       // for array
 #include <bit>         // for bit_width
-#include <iostream>    // for cout, cerr
+#include <iostream>    // for ostream, cerr
 #include <iterator>    // for back_inserter, distance
 #include <map>         // for map
 #include <string>      // for string
+#include <string_view> // for string_view
 #include <type_traits> // for remove_const_t
 #include <vector>      // for vector
 
@@ -232,6 +233,7 @@ void Board::save_to_cache() {
 
 void Board::drop_rock() {
     ++rock_number;
+    AOC_COUNTER("day17.rocks_simulated", 1);
     bool debug = rock_number < 3;
     rock_pos = internal_height + 3;
     rock_shape = ROCK_SHAPES[rock_index];
@@ -298,6 +300,7 @@ void Board::drop_rock() {
 }
 
 void Board::drop_until(long count) {
+    AOC_TIMER("day17.drop_until");
     while (rock_number < count && !(found_loop && at_loop_start)) {
         drop_rock();
     }
@@ -311,6 +314,7 @@ void Board::drop_until(long count) {
     long loop_height = loop_end.height - loop_start.height;
     long iter_count = (count - rock_number) / loop_size;
     rock_number += loop_size * iter_count;
+    AOC_COUNTER("day17.rocks_skipped", loop_size * iter_count);
     floor_height += loop_height * iter_count;
     if constexpr (aoc::DEBUG) {
         std::cerr << "skipped to rock " << rock_number
@@ -350,22 +354,24 @@ std::ostream &operator<<(std::ostream &os, const Board &board) {
     return os;
 }
 
-} // namespace aoc::day17
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
     std::string jets;
     infile >> jets;
+    aoc::mark_parsed();
 
     aoc::day17::Board board{jets};
     board.drop_until(2022);
-    std::cout << board.height() << "\n";
+    out << board.height() << "\n";
     board.drop_until(1000000000000);
     if constexpr (aoc::DEBUG) {
         std::cerr << "Final board:\n" << board << "\n";
     }
-    std::cout << board.height() << "\n";
-
-    return 0;
+    out << board.height() << "\n";
 }
+
+const SolutionRegistrar registrar{17, solve};
+
+} // namespace aoc::day17
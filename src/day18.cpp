@@ -6,20 +6,17 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cassert>    // for assert
-#include <functional> // for function
-#include <iostream>   // for cout
-#include <queue>      // for queue
-#include <sstream>    // for istringstream
-#include <string>     // for string, getline
-#include <vector>     // for vector
+#include <cassert>     // for assert
+#include <cstddef>     // for size_t
+#include <iostream>    // for ostream
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day18 {
 
 struct Cell {
     bool lava : 1 = false;
     bool exterior : 1 = false;
-    bool flood_visited : 1 = false;
 };
 static_assert(sizeof(Cell) == 1, "Cell not packed");
 
@@ -46,8 +43,8 @@ class Grid3D {
         return index >= 0 && index < side_length * side_length * side_length;
     }
 
-    void for_each_neighbor(int x, int y, int z,
-                           std::function<void(int, int, int)> func) {
+    template <typename Func>
+    void for_each_neighbor(int x, int y, int z, Func func) {
         for (int delta : {-1, +1}) {
             for (int *var : {&x, &y, &z}) {
                 *var += delta;
@@ -59,7 +56,8 @@ class Grid3D {
         }
     }
 
-    void for_each_neighbor(int index, std::function<void(int)> func) {
+    template <typename Func>
+    void for_each_neighbor(int index, Func func) {
         for (int delta : {-1, +1}) {
             for (int stride : {1, side_length, side_length * side_length}) {
                 index += delta * stride;
@@ -93,22 +91,23 @@ class Grid3D {
     }
 
     void flood_fill_exterior() {
-        // get empty cell on an edge
-        int initial_index =
+        // start from an empty cell on an edge
+        std::size_t initial_index =
             to_index(side_length - 1, side_length - 1, side_length - 1);
-        std::queue<int> pending_indices{{initial_index}};
-        while (!pending_indices.empty()) {
-            int index = pending_indices.front();
-            pending_indices.pop();
-            if (raw_grid[index].flood_visited)
-                continue;
-            raw_grid[index].flood_visited = true;
-            if (raw_grid[index].lava)
-                continue;
-            raw_grid[index].exterior = true;
-            for_each_neighbor(
-                index, [&](int nindex) { pending_indices.emplace(nindex); });
-        }
+        aoc::GraphSearch search;
+        search.bfs(
+            raw_grid.size(), {initial_index},
+            [&](std::size_t index, auto push) {
+                for_each_neighbor(index, [&](int nindex) {
+                    if (!raw_grid[nindex].lava) {
+                        push(nindex);
+                    }
+                });
+            },
+            [&](std::size_t index, int) {
+                raw_grid[index].exterior = true;
+                return false;
+            });
     }
 
     int count_exposed_sides(int x, int y, int z, bool exterior) {
@@ -125,23 +124,16 @@ class Grid3D {
     }
 };
 
-} // namespace aoc::day18
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
-
-    using namespace aoc::day18;
+void solve(std::string_view text, std::ostream &out) {
     // max value is 21; add 2 extra layers so flood-fill can reach everywhere
     Grid3D grid{21 + 1 + 2};
-    // read file line-by-line
-    std::string line;
-    while (std::getline(infile, line)) {
-        std::istringstream ss{line};
-        int x, y, z;
-        char c;
-        ss >> x >> c >> y >> c >> z;
-        grid.set(++x, ++y, ++z);
+    for (std::string_view line : aoc::lines(text)) {
+        auto [x, rest] = aoc::split_once(line, ",");
+        auto [y, z] = aoc::split_once(rest, ",");
+        grid.set(aoc::parse_int(x) + 1, aoc::parse_int(y) + 1,
+                 aoc::parse_int(z) + 1);
     }
+    aoc::mark_parsed();
     int exposed_sides = 0;
     for (int x = 0; x < grid.side_length; ++x) {
         for (int y = 0; y < grid.side_length; ++y) {
@@ -150,7 +142,7 @@ int main(int argc, char **argv) {
             }
         }
     }
-    std::cout << exposed_sides << std::endl;
+    out << exposed_sides << std::endl;
     grid.flood_fill_exterior();
     exposed_sides = 0;
     for (int x = 0; x < grid.side_length; ++x) {
@@ -160,6 +152,9 @@ int main(int argc, char **argv) {
             }
         }
     }
-    std::cout << exposed_sides << std::endl;
-    return 0;
+    out << exposed_sides << std::endl;
 }
+
+const SolutionRegistrar registrar{18, solve};
+
+} // namespace aoc::day18
@@ -6,12 +6,17 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm> // for max, max_element
-#include <array>     // for array
-#include <cassert>   // for assert
-#include <iostream>  // for cout, cerr
-#include <limits>    // for numeric_limits
-#include <vector>    // for vector
+#include <algorithm>   // for max, min
+#include <array>       // for array
+#include <cassert>     // for assert
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t, uint64_t
+#include <iostream>    // for ostream, cerr
+#include <limits>      // for numeric_limits
+#include <optional>    // for optional
+#include <span>        // for span
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day19 {
 
@@ -99,229 +104,231 @@ struct Blueprint {
         max_cost[GEODE] = std::numeric_limits<Cost::value_type>::max();
     }
 };
-std::istream &operator>>(std::istream &is, Blueprint &bp) {
-    using namespace aoc;
+aoc::Scanner &operator>>(aoc::Scanner &scan, Blueprint &bp) {
+    using cost_t = Cost::value_type;
     // "Blueprint <n>:"
-    if (!(is >> skip(1))) {
-        return is;
+    if (!scan.skip_tokens(1)) {
+        return scan;
     }
-    is >> bp.id >> skip(1);
+    bp.id = scan.next_int();
+    scan.skip_tokens(1);
     // "Each ore robot costs <n> ore."
-    is >> skip(4) >> as_number{bp.robot_costs[ORE][ORE]} >> skip(1);
+    bp.robot_costs[ORE][ORE] = scan.skip_tokens(4).next_int<cost_t>();
+    scan.skip_tokens(1);
     // "Each clay robot costs <n> ore."
-    is >> skip(4) >> as_number{bp.robot_costs[CLAY][ORE]} >> skip(1);
+    bp.robot_costs[CLAY][ORE] = scan.skip_tokens(4).next_int<cost_t>();
+    scan.skip_tokens(1);
     // "Each obsidian robot costs <n> ore and <n> clay."
-    is >> skip(4) >> as_number{bp.robot_costs[OBSIDIAN][ORE]} >> skip(2) >>
-        as_number{bp.robot_costs[OBSIDIAN][CLAY]} >> skip(1);
+    bp.robot_costs[OBSIDIAN][ORE] = scan.skip_tokens(4).next_int<cost_t>();
+    bp.robot_costs[OBSIDIAN][CLAY] = scan.skip_tokens(2).next_int<cost_t>();
+    scan.skip_tokens(1);
     // "Each geode robot costs <n> ore and <n> obsidian."
-    is >> skip(4) >> as_number{bp.robot_costs[GEODE][ORE]} >> skip(2) >>
-        as_number{bp.robot_costs[GEODE][OBSIDIAN]} >> skip(1);
+    bp.robot_costs[GEODE][ORE] = scan.skip_tokens(4).next_int<cost_t>();
+    bp.robot_costs[GEODE][OBSIDIAN] = scan.skip_tokens(2).next_int<cost_t>();
+    scan.skip_tokens(1);
     bp.update_max_costs();
-    return is;
-}
-
-// using a template parameter for remaining_time cuts the runtime in half
-template <int remaining_time>
-int find_best_dfs(const Blueprint &bp,
-                  const Resources &resources = {0, 0, 0, 0},
-                  const Robots &robots = {1, 0, 0, 0}) {
-    if constexpr (remaining_time <= 0) {
-        return resources[GEODE];
-    } else {
-        constexpr int new_time = remaining_time - 1;
-        ResourceVector next_resources = resources;
-        next_resources += robots;
-        if (resources.can_afford(bp.robot_costs[GEODE])) {
-            // always build a geode robot if we can afford it
-            return find_best_dfs<new_time>(
-                bp, next_resources - bp.robot_costs[GEODE],
-                robots + ResourceType::GEODE);
-        } else {
-            int best = 0;
-            for (ResourceType type : {OBSIDIAN, CLAY, ORE}) {
-                if (robots[type] < bp.max_cost[type] &&
-                    resources.can_afford(bp.robot_costs[type])) {
-                    best = std::max(
-                        best, find_best_dfs<new_time>(
-                                  bp, next_resources - bp.robot_costs[type],
-                                  robots + type));
-                }
-            }
-            best = std::max(
-                best, find_best_dfs<new_time>(bp, next_resources, robots));
-            return best;
-        }
-    }
+    return scan;
 }
 
 struct State {
-    const Resources resources;
-    const Robots robots;
-    bool good = true;
+    Resources resources{0, 0, 0, 0};
+    Robots robots{1, 0, 0, 0};
+    int remaining_time = 0;
+};
 
-    State() : resources({0, 0, 0, 0}), robots({1, 0, 0, 0}) {}
-    State(const Resources &resources, const Robots &robots)
-        : resources(resources), robots(robots) {}
+// the most geodes a blueprint can open, as a problem for aoc::BranchAndBound
+class GeodeProblem {
+    const Blueprint &bp;
 
-    bool pareto_dominates(const State &other) const {
-        // for one state to pareto dominate another, it must be no worse in any
-        // category, and better in at least one.
-        bool better = false;
-        for (int i = 0; i < 4; ++i) {
-            if (resources[i] < other.resources[i]) {
-                return false;
-            }
-            if (resources[i] > other.resources[i]) {
-                better = true;
-            }
-            if (robots[i] < other.robots[i]) {
-                return false;
+  public:
+    using state_type = State;
+
+    explicit GeodeProblem(const Blueprint &bp) : bp(bp) {}
+
+    // the geodes opened by the end if no more robots are built
+    int value(const State &state) const {
+        return state.resources[GEODE] +
+               state.robots[GEODE] * state.remaining_time;
+    }
+
+    // Simulates the remaining minutes as if ore were free and a robot of
+    // every other type could be built each minute, as long as there's enough
+    // clay or obsidian for it.
+    int bound(const State &state) const {
+        int clay = state.resources[CLAY];
+        int obsidian = state.resources[OBSIDIAN];
+        int geodes = state.resources[GEODE];
+        int clay_robots = state.robots[CLAY];
+        int obsidian_robots = state.robots[OBSIDIAN];
+        int geode_robots = state.robots[GEODE];
+        for (int t = state.remaining_time; t > 0; --t) {
+            const bool build_obsidian =
+                clay >= bp.robot_costs[OBSIDIAN][CLAY];
+            const bool build_geode =
+                obsidian >= bp.robot_costs[GEODE][OBSIDIAN];
+            if (build_obsidian) {
+                clay -= bp.robot_costs[OBSIDIAN][CLAY];
             }
-            if (robots[i] > other.robots[i]) {
-                better = true;
+            if (build_geode) {
+                obsidian -= bp.robot_costs[GEODE][OBSIDIAN];
             }
+            clay += clay_robots;
+            obsidian += obsidian_robots;
+            geodes += geode_robots;
+            ++clay_robots;
+            obsidian_robots += build_obsidian;
+            geode_robots += build_geode;
         }
-        return better;
+        return geodes;
     }
 
-    bool operator==(const State &other) const {
-        return resources == other.resources && robots == other.robots;
+    // Everything but the geodes, which only add to the value. Having more of
+    // a resource than could ever be spent is the same as having just enough,
+    // which merges a lot more states.
+    std::uint64_t key(const State &state) const {
+        const int t = state.remaining_time;
+        std::uint64_t key = t;
+        for (ResourceType type : {ORE, CLAY, OBSIDIAN}) {
+            const int usable =
+                std::min<int>(state.resources[type], bp.max_cost[type] * t);
+            if constexpr (!aoc::FAST) {
+                assert(usable < (1 << 10) && state.robots[type] < (1 << 6));
+            }
+            key = key << 10 | usable;
+            key = key << 6 | state.robots[type];
+        }
+        return key << 6 | state.robots[GEODE];
     }
-};
 
-int find_best_bfs(const Blueprint &bp, const int total_time) {
-    if constexpr (aoc::DEBUG) {
-        std::cerr << "\nBlueprint " << bp.id << ":\n";
-    }
-    std::vector<State> curr_queue{{State()}};
-    std::vector<State> next_queue{};
-    [[maybe_unused]] bool do_print = false;
-    for (int remaining_time = total_time; remaining_time > 0;
-         --remaining_time) {
-        if constexpr (aoc::DEBUG) {
-            if (curr_queue.size() > 1000) {
-                do_print = true;
-            }
-            if (do_print) {
-                std::cerr << "minute " << total_time - remaining_time + 1
-                          << ":   " << curr_queue.size() << " branches\n";
-            }
+    template <typename Push>
+    void expand(const State &state, Push push) const {
+        if (state.remaining_time == 0) {
+            return;
         }
-        for (auto it = curr_queue.begin(); it != curr_queue.end(); ++it) {
-            State &state = *it;
-            if (!state.good) {
-                continue;
-            }
-            // This is a trade-off between the O(n^2) cost of checking all pairs
-            // for Pareto dominance and the O(c^t) growth of the search tree.
-            // The search tree size seems to be more important at the start, so
-            // this turns it off when we get close to the end.
-            // ~5 works best for the full input, ~8 is best for the example
-            if (remaining_time > 6) {
-                for (auto other_it = it + 1; other_it != curr_queue.end();
-                     ++other_it) {
-                    if (*other_it == state ||
-                        state.pareto_dominates(*other_it)) {
-                        other_it->good = false;
-                    } else if (other_it->pareto_dominates(state)) {
-                        state.good = false;
-                        break;
-                    }
-                }
-            }
-            if (!state.good) {
-                continue;
-            }
-            const Resources next_resources = state.resources + state.robots;
-            if (state.resources.can_afford(bp.robot_costs[GEODE])) {
-                // always build a geode robot if we can afford it
-                next_queue.emplace_back(
-                    State(next_resources - bp.robot_costs[GEODE],
-                          state.robots + GEODE));
-            } else {
-                for (ResourceType type : {OBSIDIAN, CLAY, ORE}) {
-                    if (state.robots[type] < bp.max_cost[type] &&
-                        state.resources.can_afford(bp.robot_costs[type])) {
-                        next_queue.emplace_back(next_resources -
-                                                    bp.robot_costs[type],
-                                                state.robots + type);
-                    }
-                }
-                next_queue.emplace_back(next_resources, state.robots);
+        const Resources next_resources = state.resources + state.robots;
+        const int next_time = state.remaining_time - 1;
+        if (state.resources.can_afford(bp.robot_costs[GEODE])) {
+            // always build a geode robot if we can afford it
+            push(State{next_resources - bp.robot_costs[GEODE],
+                       state.robots + GEODE, next_time});
+            return;
+        }
+        for (ResourceType type : {OBSIDIAN, CLAY, ORE}) {
+            if (state.robots[type] < bp.max_cost[type] &&
+                state.resources.can_afford(bp.robot_costs[type])) {
+                push(State{next_resources - bp.robot_costs[type],
+                           state.robots + type, next_time});
             }
         }
-        curr_queue.clear();
-        std::swap(curr_queue, next_queue);
+        push(State{next_resources, state.robots, next_time});
     }
+};
+
+int find_best(const Blueprint &bp, const int total_time) {
+    AOC_TIMER("day19.find_best");
+    GeodeProblem problem{bp};
+    // with this bound, best first rarely expands a state it didn't need to
+    aoc::BranchAndBound search{
+        problem,
+        aoc::SearchOptions::from_env({aoc::SearchStrategy::best_first})};
+    State initial{};
+    initial.remaining_time = total_time;
+    const int best = search.run(initial);
+    AOC_COUNTER("day19.states_expanded", search.stats().expanded);
+    AOC_COUNTER("day19.states_generated", search.stats().generated);
+    AOC_COUNTER("day19.states_pruned",
+                search.stats().pruned_bound + search.stats().pruned_duplicate);
     if constexpr (aoc::DEBUG) {
-        if (do_print) {
-            std::cerr << "final queue: " << curr_queue.size() << " branches\n";
-        }
+        std::cerr << "Blueprint " << bp.id << ", " << total_time
+                  << " minutes: " << search.stats() << "\n";
     }
-    return std::ranges::max_element(
-               curr_queue, {},
-               [](const State &state) -> int { return state.resources[GEODE]; })
-        ->resources[GEODE];
+    return best;
 }
 
-} // namespace aoc::day19
+// layout version of the blueprint records in the input cache
+constexpr std::uint32_t CACHE_VERSION = 1;
 
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    // the blueprints either point into the input cache, or into parsed
+    std::vector<Blueprint> parsed{};
+    std::span<const Blueprint> blueprints;
+    std::optional<aoc::InputCache> cache =
+        aoc::InputCache::load(text, 19, CACHE_VERSION);
+    if (cache) {
+        blueprints = cache->section<Blueprint>(0);
+    } else {
+        aoc::Scanner scan{text};
+        Blueprint bp{};
+        while (scan >> bp) {
+            parsed.push_back(bp);
+        }
+        aoc::InputCacheWriter{}.add(parsed).save(text, 19, CACHE_VERSION);
+        blueprints = parsed;
+    }
+    aoc::mark_parsed();
 
-    using namespace aoc::day19;
-    std::vector<Blueprint> first_three;
+    // the blueprints are independent, so search them in parallel
+    std::vector<int> max_geodes(blueprints.size());
+    aoc::parallel_for(0, blueprints.size(), [&](std::size_t i) {
+        max_geodes[i] = find_best(blueprints[i], 24);
+    });
     int total_quality = 0;
-    {
-        Blueprint bp{};
-        while (infile >> bp) {
-            if (first_three.size() < 3) {
-                first_three.push_back(bp);
-            }
-            int max_geodes = find_best_bfs(bp, 24);
-            if constexpr (aoc::DEBUG) {
-                std::cerr << "Blueprint " << bp.id
-                          << ": max geodes opened = " << max_geodes << "\n";
-            }
-            total_quality += max_geodes * bp.id;
+    for (std::size_t i = 0; i < blueprints.size(); ++i) {
+        if constexpr (aoc::DEBUG) {
+            std::cerr << "Blueprint " << blueprints[i].id
+                      << ": max geodes opened = " << max_geodes[i] << "\n";
         }
+        total_quality += max_geodes[i] * blueprints[i].id;
     }
 
-    std::cout << total_quality << "\n";
+    out << total_quality << "\n";
+    // check the known answers for the example and my input; fast mode skips
+    // this so it can run on generated inputs
+    const std::span<const Blueprint> first_three =
+        blueprints.first(std::min<std::size_t>(3, blueprints.size()));
     const bool is_example = first_three.size() == 2;
-    if (is_example) {
-        assert(total_quality == 33);
-    } else {
-        assert(total_quality == 1092);
+    if constexpr (!aoc::FAST) {
+        if (is_example) {
+            assert(total_quality == 33);
+        } else {
+            assert(total_quality == 1092);
+        }
     }
 
     // part 2
+    aoc::parallel_for(0, first_three.size(), [&](std::size_t i) {
+        max_geodes[i] = find_best(first_three[i], 32);
+    });
     int product = 1;
-    for (const Blueprint &bp : first_three) {
-        int max_geodes = find_best_bfs(bp, 32);
+    for (std::size_t i = 0; i < first_three.size(); ++i) {
+        const Blueprint &bp = first_three[i];
         if constexpr (aoc::DEBUG) {
             std::cerr << "Blueprint " << bp.id
-                      << ": max geodes opened = " << max_geodes << "\n";
+                      << ": max geodes opened = " << max_geodes[i] << "\n";
         }
-        if (is_example) {
-            if (bp.id == 1) {
-                assert(max_geodes == 56);
-            } else if (bp.id == 2) {
-                assert(max_geodes == 62);
-            }
-        } else {
-            if (bp.id == 1) {
-                assert(max_geodes == 14);
-            } else if (bp.id == 2) {
-                assert(max_geodes == 11);
-            } else if (bp.id == 3) {
-                assert(max_geodes == 23);
+        if constexpr (!aoc::FAST) {
+            if (is_example) {
+                if (bp.id == 1) {
+                    assert(max_geodes[i] == 56);
+                } else if (bp.id == 2) {
+                    assert(max_geodes[i] == 62);
+                }
+            } else {
+                if (bp.id == 1) {
+                    assert(max_geodes[i] == 14);
+                } else if (bp.id == 2) {
+                    assert(max_geodes[i] == 11);
+                } else if (bp.id == 3) {
+                    assert(max_geodes[i] == 23);
+                }
             }
         }
-        product *= max_geodes;
+        product *= max_geodes[i];
     }
 
-    std::cout << product << "\n";
-
-    return 0;
+    out << product << "\n";
 }
+
+const SolutionRegistrar registrar{19, solve};
+
+} // namespace aoc::day19
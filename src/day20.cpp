@@ -6,11 +6,10 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cstdlib>  // for abs
-#include <iostream> // for cout, cerr
-#include <memory>   // for unique_ptr, make_unique
-#include <utility>  // for move
-#include <vector>   // for vector
+#include <cstdlib>     // for abs
+#include <iostream>    // for ostream, cerr
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day20 {
 template <typename T>
@@ -70,8 +69,9 @@ class CircularLinkedList {
     using Node = CircularLinkedNode<T>;
 
   private:
-    using UniquePtr = std::unique_ptr<Node>;
-    std::vector<UniquePtr> nodes;
+    Arena arena{};
+    // in their original order
+    std::vector<Node *> nodes;
     Node *head = nullptr;
     Node *zero = nullptr;
 
@@ -88,17 +88,16 @@ class CircularLinkedList {
 
 template <typename T>
 void CircularLinkedList<T>::push_back(const T &value) {
-    std::unique_ptr<Node> node_ptr = std::make_unique<Node>(value);
-    Node *raw_ptr = node_ptr.get();
+    Node *node = arena.make<Node>(value);
     if (size() == 0) {
-        head = raw_ptr;
+        head = node;
     } else {
-        nodes.back()->insert_after(raw_ptr);
+        nodes.back()->insert_after(node);
     }
     if (value == 0) {
-        zero = raw_ptr;
+        zero = node;
     }
-    nodes.emplace_back(std::move(node_ptr));
+    nodes.push_back(node);
 }
 
 template <typename T>
@@ -119,7 +118,7 @@ void CircularLinkedList<T>::mix() {
     if constexpr (aoc::DEBUG) {
         std::cerr << "initial arrangement:\n";
     }
-    for (const std::unique_ptr<Node> &node : nodes) {
+    for (Node *node : nodes) {
         if constexpr (aoc::DEBUG) {
             std::cerr << *this << "\n";
             std::cerr << "\nmoving " << node->data << ":\n";
@@ -127,7 +126,7 @@ void CircularLinkedList<T>::mix() {
         if (node->data == 0) {
             continue;
         }
-        auto *ptr = node.get();
+        auto *ptr = node;
         if (ptr == head) {
             head = ptr->next;
             if constexpr (aoc::DEBUG) {
@@ -142,16 +141,16 @@ void CircularLinkedList<T>::mix() {
         }
         ptr = advance(ptr, shift);
         if (ptr->next == head && node->data > 0) {
-            head = node.get();
+            head = node;
             if constexpr (aoc::DEBUG) {
                 std::cerr << "(updated head to " << head->data
                           << " after inserting)\n";
             }
         }
         if (shift > 0) {
-            ptr->insert_after(node.get());
+            ptr->insert_after(node);
         } else {
-            ptr->insert_before(node.get());
+            ptr->insert_before(node);
         }
     }
     if constexpr (aoc::DEBUG) {
@@ -173,12 +172,10 @@ T CircularLinkedList<T>::calc_sum() const {
     return sum;
 }
 
-} // namespace aoc::day20
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
-    using namespace aoc::day20;
     // need to store pointers here since the vector may change capacity
     CircularLinkedList<long> list_1;
     CircularLinkedList<long> list_2;
@@ -188,9 +185,10 @@ int main(int argc, char **argv) {
         list_1.push_back(value);
         list_2.push_back(value * 811589153);
     }
+    aoc::mark_parsed();
 
     list_1.mix();
-    std::cout << list_1.calc_sum() << "\n";
+    out << list_1.calc_sum() << "\n";
 
     for (int i = 0; i < 10; ++i) {
         list_2.mix();
@@ -198,7 +196,9 @@ int main(int argc, char **argv) {
             std::cerr << "\n";
         }
     }
-    std::cout << list_2.calc_sum() << "\n";
-
-    return 0;
+    out << list_2.calc_sum() << "\n";
 }
+
+const SolutionRegistrar registrar{20, solve};
+
+} // namespace aoc::day20
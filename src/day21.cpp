@@ -6,14 +6,12 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cassert>   // for assert
-#include <iostream>  // for cout, cerr
-#include <map>       // for map
-#include <memory>    // for shared_ptr, make_shared
-#include <queue>     // for queue
-#include <sstream>   // for istringstream
-#include <stdexcept> // for invalid_argument
-#include <string>    // for string, getline, stol
+#include <cassert>     // for assert
+#include <iostream>    // for ostream, cerr
+#include <map>         // for map
+#include <queue>       // for queue
+#include <string>      // for string
+#include <string_view> // for string_view
 
 namespace aoc::day21 {
 
@@ -90,7 +88,8 @@ struct Unknown : public Expression {
     }
 };
 
-using expr_ptr = std::shared_ptr<Expression>;
+// expressions are owned by an Arena
+using expr_ptr = Expression *;
 
 struct BinaryOp : public Expression {
     Operation op;
@@ -166,41 +165,42 @@ void BinaryOp::equate(long value) {
     }
 }
 
-expr_ptr add(expr_ptr lhs, expr_ptr rhs) {
+expr_ptr add(Arena &arena, expr_ptr lhs, expr_ptr rhs) {
     if (lhs->has_value() && rhs->has_value()) {
-        return std::make_shared<Integer>(lhs->get_value() + rhs->get_value());
+        return arena.make<Integer>(lhs->get_value() + rhs->get_value());
     }
-    return std::make_shared<BinaryOp>(Operation::add, lhs, rhs);
+    return arena.make<BinaryOp>(Operation::add, lhs, rhs);
 }
-expr_ptr subtract(expr_ptr lhs, expr_ptr rhs) {
+expr_ptr subtract(Arena &arena, expr_ptr lhs, expr_ptr rhs) {
     if (lhs->has_value() && rhs->has_value()) {
-        return std::make_shared<Integer>(lhs->get_value() - rhs->get_value());
+        return arena.make<Integer>(lhs->get_value() - rhs->get_value());
     }
-    return std::make_shared<BinaryOp>(Operation::subtract, lhs, rhs);
+    return arena.make<BinaryOp>(Operation::subtract, lhs, rhs);
 }
-expr_ptr multiply(expr_ptr lhs, expr_ptr rhs) {
+expr_ptr multiply(Arena &arena, expr_ptr lhs, expr_ptr rhs) {
     if (lhs->has_value() && rhs->has_value()) {
-        return std::make_shared<Integer>(lhs->get_value() * rhs->get_value());
+        return arena.make<Integer>(lhs->get_value() * rhs->get_value());
     }
-    return std::make_shared<BinaryOp>(Operation::multiply, lhs, rhs);
+    return arena.make<BinaryOp>(Operation::multiply, lhs, rhs);
 }
-expr_ptr divide(auto lhs, auto rhs) {
+expr_ptr divide(Arena &arena, expr_ptr lhs, expr_ptr rhs) {
     if (lhs->has_value() && rhs->has_value()) {
-        return std::make_shared<Integer>(lhs->get_value() / rhs->get_value());
+        return arena.make<Integer>(lhs->get_value() / rhs->get_value());
     }
-    return std::make_shared<BinaryOp>(Operation::divide, lhs, rhs);
+    return arena.make<BinaryOp>(Operation::divide, lhs, rhs);
 }
 
 struct Monkey {
     std::string name{};
     bool done = false;
-    expr_ptr number;
+    expr_ptr number = nullptr;
 
     char op;
     std::string lhs_name;
     std::string rhs_name;
 
-    void evaluate(const std::map<std::string, expr_ptr> &numbers) {
+    void evaluate(const std::pmr::map<std::string, expr_ptr> &numbers,
+                  Arena &arena) {
         if (done) {
             return;
         }
@@ -216,16 +216,16 @@ struct Monkey {
         expr_ptr lhs = lhs_it->second, rhs = rhs_it->second;
         switch (op) {
         case '+':
-            number = add(lhs, rhs);
+            number = add(arena, lhs, rhs);
             break;
         case '-':
-            number = subtract(lhs, rhs);
+            number = subtract(arena, lhs, rhs);
             break;
         case '*':
-            number = multiply(lhs, rhs);
+            number = multiply(arena, lhs, rhs);
             break;
         case '/':
-            number = divide(lhs, rhs);
+            number = divide(arena, lhs, rhs);
             break;
         case '=':
             if (!lhs->has_value()) {
@@ -237,43 +237,45 @@ struct Monkey {
             } else {
                 assert(false);
             }
-            number = std::make_shared<Integer>(1);
+            number = arena.make<Integer>(1);
         }
         done = true;
     }
 };
 
-Monkey *read_monkey(std::istream &is) {
-    Monkey *monkey = new Monkey();
-    if (!std::getline(is, monkey->name, ':')) {
-        delete monkey;
-        return nullptr;
-    }
-    std::string job;
-    std::getline(is, job);
-    try {
-        monkey->number = std::make_shared<Integer>(std::stol(job));
+Monkey *read_monkey(std::string_view line, Arena &arena) {
+    auto [name, job] = aoc::split_once(line, ": ");
+    Monkey *monkey = arena.make<Monkey>();
+    monkey->name = name;
+    aoc::Scanner scan{job};
+    long value = scan.next_int<long>();
+    if (scan) {
+        monkey->number = arena.make<Integer>(value);
         monkey->done = true;
-    } catch (std::invalid_argument) {
-        std::istringstream ss{job};
-        ss >> monkey->lhs_name >> monkey->op >> monkey->rhs_name;
+    } else {
+        aoc::Scanner expr{job};
+        monkey->lhs_name = expr.next_token();
+        monkey->op = expr.next_char();
+        monkey->rhs_name = expr.next_token();
     }
     return monkey;
 }
 
-void part_1(std::istream &is) {
+void part_1(std::string_view text, std::ostream &out) {
+    // holds all the monkeys and expressions, and the map's nodes
+    Arena arena;
     std::queue<Monkey *> pending_monkeys;
-    Monkey *monkey;
-    while ((monkey = read_monkey(is)) != nullptr) {
-        pending_monkeys.push(monkey);
+    for (std::string_view line : aoc::lines(text)) {
+        pending_monkeys.push(read_monkey(line, arena));
     }
+    Monkey *monkey;
 
-    std::map<std::string, expr_ptr> numbers{};
+    std::pmr::map<std::string, expr_ptr> numbers{&arena};
     while (!pending_monkeys.empty()) {
         monkey = pending_monkeys.front();
         pending_monkeys.pop();
         if (!monkey->done) {
-            monkey->evaluate(numbers);
+            monkey->evaluate(numbers, arena);
         }
         if (monkey->done) {
             if constexpr (aoc::DEBUG) {
@@ -281,24 +283,25 @@ void part_1(std::istream &is) {
                           << monkey->number->get_value() << "\n";
             }
             numbers[monkey->name] = monkey->number;
-            delete monkey;
         } else {
             pending_monkeys.push(monkey);
         }
     }
 
-    std::cout << numbers["root"]->get_value() << std::endl;
+    out << numbers["root"]->get_value() << std::endl;
 }
 
-void part_2(std::istream &is) {
+void part_2(std::string_view text, std::ostream &out) {
+    // holds all the monkeys and expressions, and the map's nodes
+    Arena arena;
     std::queue<Monkey *> pending_monkeys;
-    Monkey *monkey;
-    while ((monkey = read_monkey(is)) != nullptr) {
-        pending_monkeys.push(monkey);
+    for (std::string_view line : aoc::lines(text)) {
+        pending_monkeys.push(read_monkey(line, arena));
     }
+    Monkey *monkey;
 
-    expr_ptr humn = std::make_shared<Unknown>();
-    std::map<std::string, expr_ptr> numbers{};
+    expr_ptr humn = arena.make<Unknown>();
+    std::pmr::map<std::string, expr_ptr> numbers{&arena};
     while (!pending_monkeys.empty()) {
         monkey = pending_monkeys.front();
         pending_monkeys.pop();
@@ -308,7 +311,7 @@ void part_2(std::istream &is) {
             monkey->number = humn;
         }
         if (!monkey->done) {
-            monkey->evaluate(numbers);
+            monkey->evaluate(numbers, arena);
         }
         if (monkey->done) {
             if constexpr (aoc::DEBUG) {
@@ -316,23 +319,20 @@ void part_2(std::istream &is) {
                           << monkey->number->get_value() << "\n";
             }
             numbers[monkey->name] = monkey->number;
-            delete monkey;
         } else {
             pending_monkeys.push(monkey);
         }
     }
 
     assert(humn->has_value());
-    std::cout << humn->get_value() << std::endl;
+    out << humn->get_value() << std::endl;
 }
 
-} // namespace aoc::day21
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
-    aoc::day21::part_1(infile);
-    infile.clear();
-    infile.seekg(0);
-    aoc::day21::part_2(infile);
-    return 0;
+void solve(std::string_view text, std::ostream &out) {
+    part_1(text, out);
+    part_2(text, out);
 }
+
+const SolutionRegistrar registrar{21, solve};
+
+} // namespace aoc::day21
@@ -6,18 +6,17 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm> // for max
-#include <cassert>   // for assert
-#include <cmath>     // for sqrt
-#include <iostream>  // for cout, cerr
-#include <map>       // for map
-#include <memory>    // for shared_ptr, weak_ptr, enable_shared_from_this,
-                     //     unique_ptr, make_unique
-#include <compare>   // for strong_ordering
-#include <stdexcept> // for logic_error
-#include <string>    // for string, getline
-#include <utility>   // for move
-#include <vector>    // for vector
+#include <algorithm>   // for max
+#include <cassert>     // for assert
+#include <cmath>       // for sqrt
+#include <iostream>    // for ostream, cerr
+#include <map>         // for map
+#include <compare>     // for strong_ordering
+#include <stdexcept>   // for logic_error
+#include <string>      // for string, getline
+#include <string_view> // for string_view
+#include <utility>     // for move
+#include <vector>      // for vector
 
 namespace aoc::day22 {
 
@@ -46,61 +45,55 @@ Delta to_delta(const Facing &facing) {
     assert(false);
 }
 
+// Nodes are allocated in an Arena, which also holds their links.
 template <typename T>
-struct Node : public std::enable_shared_from_this<Node<T>> {
+struct Node {
   public: // member types
     using value_type = T;
-    using data_pointer = std::unique_ptr<T>;
 
   private: // member variables
-    data_pointer data;
+    T data;
 
     class Link {
-        std::weak_ptr<Node> ptr{};
+        Node *ptr = nullptr;
         Facing facing{};
 
         using element_type = Node;
         friend Node; // allow Node to access the private constructors
 
         Link() = default;
-        Link(const std::shared_ptr<Node> &r, Facing facing)
-            : ptr(r), facing(facing) {}
+        Link(Node *r, Facing facing) : ptr(r), facing(facing) {}
 
       public:
         const Facing &new_facing() const {
-            assert(ptr.lock());
+            assert(ptr);
             return facing;
         }
 
-        element_type &operator*() const { return *ptr.lock(); }
-        element_type *get() const { return ptr.lock().get(); }
+        element_type &operator*() const { return *ptr; }
+        element_type *get() const { return ptr; }
         element_type *operator->() const { return get(); }
 
-        explicit operator bool() const { return static_cast<bool>(ptr.lock()); }
+        explicit operator bool() const { return ptr != nullptr; }
     };
 
   public: // public member variables
     // Link north{}, south{}, east{}, west{};
-    std::map<Facing, Link> links{};
+    std::pmr::map<Facing, Link> links;
 
-  private:
-    explicit Node(data_pointer data) : data(std::move(data)), links() {
+    Node(T data, std::pmr::memory_resource *resource)
+        : data(std::move(data)), links(resource) {
         for (Facing facing : FACINGS) {
             links.emplace(facing, Link{});
         }
     }
 
-  public:
-    std::shared_ptr<Node> getptr() { return this->shared_from_this(); }
-    [[nodiscard]] static std::shared_ptr<Node> create(data_pointer data) {
-        return std::shared_ptr<Node>(new Node(std::move(data)));
-    }
+    void link_to(Node *other, Facing link_side, Facing new_facing);
 
-    void link_to(std::shared_ptr<Node> other, Facing link_side,
-                 Facing new_facing);
-
-    T &operator*() const { return *data; }
-    T *operator->() const { return data.get(); }
+    T &operator*() { return data; }
+    const T &operator*() const { return data; }
+    T *operator->() { return &data; }
+    const T *operator->() const { return &data; }
 
     const Link &north() const { return links.at(Facing::up); }
     const Link &south() const { return links.at(Facing::down); }
@@ -109,8 +102,7 @@ struct Node : public std::enable_shared_from_this<Node<T>> {
 };
 
 template <typename T>
-void Node<T>::link_to(std::shared_ptr<Node> other, Facing link_side,
-                      Facing new_facing) {
+void Node<T>::link_to(Node *other, Facing link_side, Facing new_facing) {
     links.at(link_side) = {other, new_facing};
 }
 
@@ -118,16 +110,22 @@ template <typename T>
 class LinkedGrid {
   public: // member types
     using value_type = T;
-    using data_pointer = std::unique_ptr<T>;
     using node_type = Node<T>;
-    using node_pointer = std::shared_ptr<node_type>;
+    using node_pointer = node_type *;
 
   private:
-    std::map<Pos, node_pointer> nodes{};
+    // owns all the nodes, and the map's tree nodes
+    Arena arena{};
+    std::pmr::map<Pos, node_pointer> nodes{&arena};
 
   public:
     node_pointer get_node(const Pos &);
-    node_pointer add_node(const Pos &, data_pointer);
+    node_pointer add_node(const Pos &, T data);
+    // removes and destroys all the nodes
+    void clear() {
+        nodes.clear();
+        arena.reset();
+    }
 
     typename decltype(nodes)::const_iterator begin() const {
         return nodes.cbegin();
@@ -151,16 +149,15 @@ auto LinkedGrid<T>::get_node(const Pos &pos) -> node_pointer {
     if (it != nodes.end()) {
         return it->second;
     }
-    return {};
+    return nullptr;
 }
 
 template <typename T>
-auto LinkedGrid<T>::add_node(const Pos &pos, data_pointer data)
-    -> node_pointer {
+auto LinkedGrid<T>::add_node(const Pos &pos, T data) -> node_pointer {
     if (nodes.contains(pos)) {
         throw std::logic_error("Grid node already exists at this position");
     }
-    auto node = node_type::create(std::move(data));
+    node_pointer node = arena.make<node_type>(std::move(data), &arena);
     nodes.emplace(pos, node);
     // link adjacent nodes
     for (Facing facing : FACINGS) {
@@ -263,8 +260,8 @@ const LinkedGrid<NodeData>::node_type *read_part_1(LinkedGrid<NodeData> &grid,
     // read file line-by-line
     std::string line;
     std::map<int, node_pointer> first_nodes_in_column{};
-    node_pointer first_node_in_line{};
-    node_pointer starting_node{};
+    node_pointer first_node_in_line = nullptr;
+    node_pointer starting_node = nullptr;
     int y = 0;
     int max_x = 0;
     while (std::getline(infile, line)) {
@@ -284,7 +281,7 @@ const LinkedGrid<NodeData>::node_type *read_part_1(LinkedGrid<NodeData> &grid,
                                         Facing::right);
                     first_node_in_line->link_to(right_node, Facing::left,
                                                 Facing::left);
-                    first_node_in_line.reset();
+                    first_node_in_line = nullptr;
                 }
                 if (first_nodes_in_column.contains(x)) {
                     // link first node and previous node
@@ -307,8 +304,7 @@ const LinkedGrid<NodeData>::node_type *read_part_1(LinkedGrid<NodeData> &grid,
                 if constexpr (aoc::DEBUG && false) {
                     std::cerr << "adding node at " << pos << "\n";
                 }
-                auto node = grid.add_node(
-                    pos, std::make_unique<NodeData>(line[x] == '#', pos));
+                auto *node = grid.add_node(pos, NodeData(line[x] == '#', pos));
                 if (!starting_node) {
                     starting_node = node;
                 }
@@ -325,7 +321,7 @@ const LinkedGrid<NodeData>::node_type *read_part_1(LinkedGrid<NodeData> &grid,
         }
         ++y;
     }
-    return starting_node.get();
+    return starting_node;
 }
 
 struct FaceLink {
@@ -417,7 +413,7 @@ read_part_2(LinkedGrid<NodeData> &grid, std::istream &infile, int face_width) {
     std::vector<Pos> face_positions{};
     // [source face index][direction to move] = {dest face index, new facing}
     std::map<FaceLink, FaceLink> face_connections{};
-    node_pointer starting_node{};
+    node_pointer starting_node = nullptr;
     int y = 0;
     while (std::getline(infile, line)) {
         for (int x = 0; x < static_cast<int>(line.size()); ++x) {
@@ -425,8 +421,7 @@ read_part_2(LinkedGrid<NodeData> &grid, std::istream &infile, int face_width) {
             if (line[x] == ' ') {
                 continue;
             }
-            auto node = grid.add_node(
-                pos, std::make_unique<NodeData>(line[x] == '#', pos));
+            auto *node = grid.add_node(pos, NodeData(line[x] == '#', pos));
             Pos face_pos = pos / face_width;
             if (!face_indices.contains(face_pos)) {
                 int source_index = face_positions.size();
@@ -526,15 +521,13 @@ read_part_2(LinkedGrid<NodeData> &grid, std::istream &infile, int face_width) {
         }
     }
 
-    return starting_node.get();
+    return starting_node;
 }
 
-} // namespace aoc::day22
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
-    using namespace aoc::day22;
     LinkedGrid<NodeData> grid{};
     const LinkedGrid<NodeData>::node_type *starting_node =
         read_part_1(grid, infile);
@@ -550,12 +543,12 @@ int main(int argc, char **argv) {
     }
     PathFollower pf{starting_node};
     pf.follow_path(infile);
-    std::cout << pf.get_password() << "\n";
+    out << pf.get_password() << "\n";
 
     int face_width = std::sqrt(grid.size() / 6);
     infile.clear();
     infile.seekg(0);
-    grid = LinkedGrid<NodeData>();
+    grid.clear();
     if constexpr (aoc::DEBUG) {
         std::cerr << "\n";
     }
@@ -572,6 +565,9 @@ int main(int argc, char **argv) {
     }
     pf = PathFollower{starting_node};
     pf.follow_path(infile);
-    std::cout << pf.get_password() << "\n";
-    return 0;
+    out << pf.get_password() << "\n";
 }
+
+const SolutionRegistrar registrar{22, solve};
+
+} // namespace aoc::day22
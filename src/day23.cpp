@@ -6,15 +6,16 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <algorithm>  // for any_of, all_of, for_each, count_if
-#include <cassert>    // for assert
-#include <cstdlib>    // for abs
-#include <deque>      // for deque
-#include <functional> // for plus
-#include <iostream>   // for cout
-#include <list>       // for list
-#include <numeric>    // for transform_reduce
-#include <string>     // for string, getline
+#include <algorithm>   // for any_of, all_of, for_each, count_if
+#include <cassert>     // for assert
+#include <cstdlib>     // for abs
+#include <deque>       // for deque
+#include <functional>  // for plus
+#include <iostream>    // for ostream
+#include <list>        // for list
+#include <numeric>     // for transform_reduce
+#include <string>      // for string, getline
+#include <string_view> // for string_view
 
 namespace aoc::day23 {
 
@@ -276,6 +277,7 @@ bool Grid::propose_move(int x, int y) {
             if constexpr (aoc::DEBUG) {
                 std::cerr << "conflict\n";
             }
+            AOC_COUNTER("day23.conflicts", 1);
             dest->conflict = true;
         } else {
             if constexpr (aoc::DEBUG) {
@@ -289,6 +291,7 @@ bool Grid::propose_move(int x, int y) {
 }
 
 bool Grid::propose_moves() {
+    AOC_TIMER("day23.propose_moves");
     check_invariants();
     bool did_anything = false;
     for (int y = y_lo; y < y_hi; ++y) {
@@ -300,10 +303,12 @@ bool Grid::propose_moves() {
 }
 
 void Grid::make_moves() {
+    AOC_TIMER("day23.make_moves");
     for (int y = y_lo; y < y_hi; ++y) {
         for (int x = x_lo; x < x_hi; ++x) {
             Cell &dest = get(x, y);
             if (dest.move_from != nullptr && !dest.conflict) {
+                AOC_COUNTER("day23.elves_moved", 1);
                 dest.move_from->is_elf = false;
                 dest.is_elf = true;
             }
@@ -325,18 +330,17 @@ std::ostream &operator<<(std::ostream &os, const Grid &grid) {
     return os;
 }
 
-} // namespace aoc::day23
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
-    using namespace aoc::day23;
     Grid grid;
     // read file line-by-line
     std::string line;
     while (std::getline(infile, line)) {
         grid.add_line(line);
     }
+    aoc::mark_parsed();
 
     if constexpr (aoc::DEBUG) {
         std::cerr << "== Initial State ==\n" << grid << "\n";
@@ -350,12 +354,15 @@ int main(int argc, char **argv) {
         }
         grid.check_invariants();
         if (round == 10) {
-            std::cout << grid.count_empty() << "\n";
+            out << grid.count_empty() << "\n";
         }
     }
     if (round < 10) {
-        std::cout << grid.count_empty() << "\n";
+        out << grid.count_empty() << "\n";
     }
-    std::cout << round + 1 << std::endl;
-    return 0;
+    out << round + 1 << std::endl;
 }
+
+const SolutionRegistrar registrar{23, solve};
+
+} // namespace aoc::day23
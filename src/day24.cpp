@@ -6,13 +6,16 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cassert>  // for assert
-#include <cstdint>  // for uint8_t
-#include <iomanip>  // for quoted
-#include <iostream> // for cout, cerr
-#include <set>      // for set
-#include <string>   // for string, getline
-#include <vector>   // for vector
+#include <algorithm>   // for fill
+#include <array>       // for array
+#include <cassert>     // for assert
+#include <cstdint>     // for uint8_t
+#include <iomanip>     // for quoted
+#include <iostream>    // for ostream, cerr
+#include <span>        // for span
+#include <string>      // for string, getline
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day24 {
 using Pos = aoc::Pos;
@@ -56,14 +59,18 @@ class Valley {
     std::vector<Blizzard> blizzards{};
 
     int time;
-    // the positions of the blizzards at the next time step
-    std::vector<std::vector<std::uint8_t>> blizzard_counts;
+    // the number of blizzards on each cell of the valley at the next time
+    // step; this only feeds update_open_cells()
+    aoc::Grid<std::uint8_t> blizzard_counts;
+    // The cells that are free of blizzards at the next time step, including
+    // the entrance and exit. This is offset by 1 row, so the entrance is on
+    // row 0 and the exit is on the last row.
+    aoc::BitGrid open_cells;
+    aoc::FrontierSearch search{};
 
     void advance_time();
-
-    bool in_bounds(const Pos &pos) const {
-        return pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height;
-    }
+    void update_open_cells();
+    static Pos to_bit_pos(const Pos &pos) { return pos + Delta(0, 1); }
 
   public:
     explicit Valley(const std::vector<std::string> &lines);
@@ -75,8 +82,10 @@ Valley::Valley(const std::vector<std::string> &lines)
       exit(width - 1, height) {
     // subtract 2 from width and height for the walls
 
-    blizzard_counts = std::vector<std::vector<std::uint8_t>>(
-        width, std::vector<std::uint8_t>(height, 0));
+    blizzard_counts = aoc::Grid<std::uint8_t>(width, height);
+    open_cells = aoc::BitGrid(width, height + 2);
+    open_cells.set(to_bit_pos(entrance));
+    open_cells.set(to_bit_pos(exit));
 
     time = 0;
     Pos pos{0, 0};
@@ -105,8 +114,7 @@ Valley::Valley(const std::vector<std::string> &lines)
                 }
                 blizzards.emplace_back(pos, direction);
                 blizzards.back().move(width, height);
-                ++blizzard_counts[blizzards.back().pos.x]
-                                 [blizzards.back().pos.y];
+                ++blizzard_counts[blizzards.back().pos];
             }
             ++pos.x;
         }
@@ -118,14 +126,14 @@ Valley::Valley(const std::vector<std::string> &lines)
 void Valley::advance_time() {
     // update blizzard positions and counts
     for (Blizzard &blizzard : blizzards) {
-        --blizzard_counts[blizzard.pos.x][blizzard.pos.y];
+        --blizzard_counts[blizzard.pos];
         blizzard.move(width, height);
-        ++blizzard_counts[blizzard.pos.x][blizzard.pos.y];
+        ++blizzard_counts[blizzard.pos];
     }
     if constexpr (aoc::DEBUG) {
         // make sure there aren't too many blizzards in any one spot
-        for (const auto &row : blizzard_counts) {
-            for (const auto count : row) {
+        for (int y = 0; y < height; ++y) {
+            for (const auto count : blizzard_counts.row(y)) {
                 assert(count <= 4);
             }
         }
@@ -133,48 +141,50 @@ void Valley::advance_time() {
     ++time;
 }
 
-int Valley::bfs(const Pos &src, const Pos &dest) {
-    std::set<Pos> curr_positions{{src}};
-    std::set<Pos> next_positions{};
-
-    while (true) {
-        for (const auto &pos : curr_positions) {
-            for (const Direction &dir : {Direction::up, Direction::down,
-                                         Direction::left, Direction::right}) {
-                Pos candidate = pos + Delta(dir, true);
-                if (candidate == dest) {
-                    advance_time();
-                    return time;
-                }
-                if (!in_bounds(candidate)) {
-                    // out-of-bounds
-                    continue;
-                }
-                if (blizzard_counts[candidate.x][candidate.y] > 0) {
-                    // would be blocked by a blizzard
-                    continue;
-                }
-                next_positions.emplace(candidate);
-            }
-            if (pos == src ||
-                (in_bounds(pos) && blizzard_counts[pos.x][pos.y] == 0)) {
-                next_positions.emplace(pos);
-            }
+void Valley::update_open_cells() {
+    using word_type = aoc::BitGrid::word_type;
+    constexpr int word_bits = aoc::BitGrid::word_bits;
+    for (int y = 0; y < height; ++y) {
+        std::span<word_type> words = open_cells.row(y + 1);
+        std::ranges::fill(words, 0);
+        std::span<const std::uint8_t> counts = blizzard_counts.row(y);
+        for (int x = 0; x < width; ++x) {
+            words[x / word_bits] |= word_type{counts[x] == 0}
+                                    << (x % word_bits);
         }
-        curr_positions.clear();
-        // advance time and swap the queues
-        advance_time();
-        assert(!next_positions.empty());
-        std::swap(curr_positions, next_positions);
     }
 }
 
-} // namespace aoc::day24
+int Valley::bfs(const Pos &src, const Pos &dest) {
+    AOC_TIMER("day24.bfs");
+    // wait in place, or move in any direction
+    constexpr std::array<Delta, 5> moves{Delta(0, 0), Delta(1, 0),
+                                         Delta(-1, 0), Delta(0, 1),
+                                         Delta(0, -1)};
+    aoc::BitGrid frontier(open_cells.width(), open_cells.height());
+    frontier.set(to_bit_pos(src));
+    const Pos target = to_bit_pos(dest);
+    auto layers = search.run(
+        frontier, moves,
+        [this](int) -> const aoc::BitGrid & {
+            // the layer after the current time
+            update_open_cells();
+            advance_time();
+            return open_cells;
+        },
+        [&](const aoc::BitGrid &positions, int) {
+            AOC_COUNTER("day24.minutes", 1);
+            AOC_COUNTER("day24.positions_expanded", positions.count());
+            return positions.test(target);
+        });
+    assert(layers.has_value());
+    return time;
+}
 
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
+    std::istream &infile = input.stream();
 
-    using namespace aoc::day24;
     // read file line-by-line
     std::string line;
     std::vector<std::string> lines;
@@ -182,12 +192,16 @@ int main(int argc, char **argv) {
         lines.push_back(line);
     }
     Valley valley{lines};
+    aoc::mark_parsed();
 
     // part 1
-    std::cout << valley.bfs(valley.entrance, valley.exit) << "\n";
+    out << valley.bfs(valley.entrance, valley.exit) << "\n";
     // go back for the snacks
     valley.bfs(valley.exit, valley.entrance);
     // return to the exit again
-    std::cout << valley.bfs(valley.entrance, valley.exit) << "\n";
-    return 0;
+    out << valley.bfs(valley.entrance, valley.exit) << "\n";
 }
+
+const SolutionRegistrar registrar{24, solve};
+
+} // namespace aoc::day24
@@ -6,15 +6,16 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <cassert>  // for assert
-#include <iostream> // for cout
-#include <map>      // for map
-#include <string>   // for string, getline
-#include <vector>   // for vector
+#include <cassert>     // for assert
+#include <iostream>    // for ostream
+#include <map>         // for map
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day25 {
 
-long snafu_to_decimal(const std::string &snafu) {
+long snafu_to_decimal(std::string_view snafu) {
     long value = 0;
     long place_value = 1;
     for (auto it = snafu.rbegin(); it != snafu.rend(); ++it) {
@@ -103,24 +104,24 @@ void test_cases() {
     }
 }
 
-} // namespace aoc::day25
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
 
-    using namespace aoc::day25;
     if constexpr (aoc::DEBUG) {
         test_cases();
     }
 
     long sum = 0;
     // read file line-by-line
-    std::string line;
-    while (std::getline(infile, line)) {
+    std::string_view line;
+    while (input.next_line(line)) {
         long value = snafu_to_decimal(line);
         assert(line == decimal_to_snafu(value));
         sum += value;
     }
-    std::cout << decimal_to_snafu(sum) << std::endl;
-    return 0;
+    out << decimal_to_snafu(sum) << std::endl;
 }
+
+const SolutionRegistrar registrar{25, solve};
+
+} // namespace aoc::day25
@@ -9,14 +9,64 @@
 #ifndef LIB_H_AT4RFPRV
 #define LIB_H_AT4RFPRV
 
-#include <algorithm>   // for max
-#include <cassert>     // for assert
-#include <compare>     // for strong_ordering
-#include <cstdlib>     // for abs, exit
-#include <fstream>     // for ifstream  // IWYU pragma: keep
-#include <iostream>    // for cout
-#include <string>      // for string
-#include <type_traits> // for is_same_v, is_signed_v, conditional_t
+#include <algorithm>          // for max, min, fill, move, any_of, copy,
+                              //     push_heap, pop_heap, sort, nth_element
+#include <array>              // for array
+#include <atomic>             // for atomic, memory_order_relaxed
+#include <bit>                // for popcount, countr_zero, rotl
+#include <cassert>            // for assert
+#include <cerrno>             // for errno
+#include <charconv>           // for from_chars
+#include <chrono>             // for steady_clock
+#include <compare>            // for strong_ordering
+#include <concepts>           // for convertible_to
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t, ptrdiff_t, byte
+#include <cstdint>            // for uint32_t, uint64_t, uintptr_t
+#include <cstdio>             // for rename, remove
+#include <cstdlib>            // for abs, exit, getenv
+#include <cstring>            // for memcpy, memchr
+#include <deque>              // for deque
+#include <exception>          // for exception_ptr, current_exception
+#include <fcntl.h>            // for open, O_RDONLY
+#include <fstream>            // for ifstream, ofstream  // IWYU pragma: keep
+#include <functional>         // for function, greater, hash
+#include <initializer_list>   // for initializer_list
+#include <iomanip>            // for setw, setprecision
+#include <iostream>           // for cout, cerr, istream, left, right, fixed
+#include <iterator>           // for forward_iterator_tag
+#include <limits>             // for numeric_limits
+#include <map>                // for map
+#include <memory>             // for unique_ptr, make_unique
+#include <memory_resource>    // for memory_resource
+#include <mutex>              // for mutex, lock_guard, unique_lock
+#include <new>                // for operator new, operator delete
+#include <optional>           // for optional, nullopt
+#include <ranges>             // for contiguous_range, range_value_t,
+                              //     view_interface
+#include <span>               // for span
+#include <stdexcept>          // for out_of_range, logic_error,
+                              //     invalid_argument
+#include <streambuf>          // for streambuf
+#include <string>             // for string, to_string
+#include <string_view>        // for string_view
+#include <sys/mman.h>         // for mmap, munmap, madvise, MADV_SEQUENTIAL
+#include <sys/stat.h>         // for fstat, stat
+#include <system_error>       // for system_error, generic_category
+#include <thread>             // for thread, hardware_concurrency, yield,
+                              //     sleep_for
+#include <type_traits>        // for is_same_v, is_signed_v, conditional_t,
+                              //     is_integral_v, is_trivially_copyable_v,
+                              //     is_trivially_destructible_v,
+                              //     remove_cvref_t
+#include <unistd.h>           // for close
+#include <unordered_map>      // for unordered_map
+#include <utility>            // for move, pair, forward, exchange, swap,
+                              //     as_const, declval
+#include <vector>             // for vector
+#ifdef __AVX2__
+#include <immintrin.h> // for __m256i, _mm256_loadu_si256, ...
+#endif
 
 namespace aoc {
 
@@ -33,14 +83,14 @@ namespace aoc {
 #endif
 
 enum class Direction : char { up = 'U', down = 'D', left = 'L', right = 'R' };
-std::istream &operator>>(std::istream &is, Direction &dir) {
+inline std::istream &operator>>(std::istream &is, Direction &dir) {
     char ch = 0;
     if (is >> ch) {
         dir = static_cast<Direction>(ch);
     }
     return is;
 }
-std::ostream &operator<<(std::ostream &os, const Direction &dir) {
+inline std::ostream &operator<<(std::ostream &os, const Direction &dir) {
     os << static_cast<char>(dir);
     return os;
 }
@@ -103,7 +153,7 @@ inline Delta operator-(Delta lhs, const Delta &rhs) {
     return lhs;
 }
 
-std::ostream &operator<<(std::ostream &os, const Delta &delta) {
+inline std::ostream &operator<<(std::ostream &os, const Delta &delta) {
     os << "Delta(" << delta.dx << ", " << delta.dy << ")";
     return os;
 }
@@ -154,66 +204,2798 @@ inline Delta operator-(const Pos &lhs, const Pos &rhs) {
     return {lhs.x - rhs.x, lhs.y - rhs.y};
 }
 
-std::ostream &operator<<(std::ostream &os, const Pos &pos) {
+inline std::ostream &operator<<(std::ostream &os, const Pos &pos) {
     os << "Pos(" << pos.x << ", " << pos.y << ")";
     return os;
 }
 
-// use an anonymous namespace to hide this implementation detail
-namespace {
+/**
+ * @brief  Contiguous row-major 2D grid indexed by Pos.
+ *
+ * The grid covers the rectangle [x_min(), x_max()] x [y_min(), y_max()], plus
+ * a border of `halo` cells on every side that can be read and written without
+ * bounds checks, so neighbor lookups don't need any special cases at the
+ * edges. Cells outside the grid are initialized to `fill`.
+ *
+ * expand_to_include() grows the grid in any direction; the storage reserves
+ * extra space on the side that grew, so repeated growth is amortized O(1) per
+ * cell. Note that growing may reallocate, which invalidates references.
+ *
+ * T shouldn't be bool, since row() returns spans over the storage.
+ */
 template <typename T>
-struct SkipInputHelper {
-    int count;
-    friend std::istream &operator>>(std::istream &is, SkipInputHelper s) {
-        T temp;
-        for (int i = 0; i < s.count && (is >> temp); ++i)
-            ;
-        return is;
+class Grid {
+  public:
+    using value_type = T;
+
+  private:
+    std::vector<T> cells{};
+    T fill{};
+    int halo = 0;
+    // logical bounds (half-open)
+    int x_lo = 0, x_hi = 0, y_lo = 0, y_hi = 0;
+    // allocated bounds (half-open), including the halo and any spare capacity
+    int alloc_x_lo = 0, alloc_x_hi = 0, alloc_y_lo = 0, alloc_y_hi = 0;
+
+    int stride() const { return alloc_x_hi - alloc_x_lo; }
+    std::size_t index(int x, int y) const {
+        if constexpr (!aoc::FAST) {
+            assert(in_padded_bounds(Pos(x, y)));
+        }
+        return static_cast<std::size_t>(y - alloc_y_lo) * stride() +
+               (x - alloc_x_lo);
+    }
+
+    // move everything into a new allocation with the given bounds
+    void reallocate(int new_x_lo, int new_x_hi, int new_y_lo, int new_y_hi);
+
+  public:
+    Grid() = default;
+    Grid(int width, int height, const T &fill = T{}, int halo = 0,
+         const Pos &origin = Pos(0, 0))
+        : fill(fill), halo(halo), x_lo(origin.x), x_hi(origin.x + width),
+          y_lo(origin.y), y_hi(origin.y + height) {
+        assert(width >= 0 && height >= 0 && halo >= 0);
+        alloc_x_lo = x_lo - halo;
+        alloc_x_hi = x_hi + halo;
+        alloc_y_lo = y_lo - halo;
+        alloc_y_hi = y_hi + halo;
+        cells.assign(static_cast<std::size_t>(stride()) *
+                         (alloc_y_hi - alloc_y_lo),
+                     fill);
+    }
+
+    int width() const { return x_hi - x_lo; }
+    int height() const { return y_hi - y_lo; }
+    bool empty() const { return width() == 0 || height() == 0; }
+    int x_min() const { return x_lo; }
+    int x_max() const { return x_hi - 1; }
+    int y_min() const { return y_lo; }
+    int y_max() const { return y_hi - 1; }
+    int halo_size() const { return halo; }
+
+    bool in_bounds(const Pos &pos) const {
+        return pos.x >= x_lo && pos.x < x_hi && pos.y >= y_lo && pos.y < y_hi;
+    }
+    // true if the position is inside the grid or its halo
+    bool in_padded_bounds(const Pos &pos) const {
+        return pos.x >= x_lo - halo && pos.x < x_hi + halo &&
+               pos.y >= y_lo - halo && pos.y < y_hi + halo;
+    }
+
+    // unchecked access (asserted outside of FAST_MODE); valid in the halo
+    T &operator[](const Pos &pos) { return cells[index(pos.x, pos.y)]; }
+    const T &operator[](const Pos &pos) const {
+        return cells[index(pos.x, pos.y)];
+    }
+    // checked access to cells inside the grid (not the halo)
+    T &at(const Pos &pos) {
+        if (!in_bounds(pos)) {
+            throw std::out_of_range("Grid::at: position out of bounds");
+        }
+        return (*this)[pos];
+    }
+    const T &at(const Pos &pos) const {
+        if (!in_bounds(pos)) {
+            throw std::out_of_range("Grid::at: position out of bounds");
+        }
+        return (*this)[pos];
+    }
+
+    // the cells in row y from x_min() to x_max(), contiguous in memory
+    std::span<T> row(int y) {
+        return {cells.data() + index(x_lo, y),
+                static_cast<std::size_t>(width())};
+    }
+    std::span<const T> row(int y) const {
+        return {cells.data() + index(x_lo, y),
+                static_cast<std::size_t>(width())};
+    }
+    // same as row(), but including the halo on either side
+    std::span<T> padded_row(int y) {
+        return {cells.data() + index(x_lo - halo, y),
+                static_cast<std::size_t>(width() + 2 * halo)};
+    }
+
+    // Linear cell indices, covering the halo and any spare capacity, for
+    // flat per-cell arrays (e.g. GraphSearch). Growing the grid renumbers
+    // the cells.
+    std::size_t num_indices() const { return cells.size(); }
+    std::size_t index_of(const Pos &pos) const { return index(pos.x, pos.y); }
+    Pos pos_of(std::size_t i) const {
+        return Pos(alloc_x_lo + static_cast<int>(i % stride()),
+                   alloc_y_lo + static_cast<int>(i / stride()));
+    }
+    // the difference in index between pos + delta and pos
+    std::ptrdiff_t index_offset(const Delta &delta) const {
+        return static_cast<std::ptrdiff_t>(delta.dy) * stride() + delta.dx;
     }
+    T &cell(std::size_t i) { return cells[i]; }
+    const T &cell(std::size_t i) const { return cells[i]; }
+
+    // grow the grid (if needed) so that pos is in bounds
+    void expand_to_include(const Pos &pos);
+    // reset every cell, including the halo, to the fill value
+    void clear() { std::ranges::fill(cells, fill); }
 };
-} // namespace
 
-template <typename T = std::string>
-SkipInputHelper<T> skip(int count = 1) {
-    return SkipInputHelper<T>{count};
+template <typename T>
+void Grid<T>::reallocate(int new_x_lo, int new_x_hi, int new_y_lo,
+                         int new_y_hi) {
+    Grid<T> other;
+    other.fill = fill;
+    other.halo = halo;
+    other.x_lo = x_lo;
+    other.x_hi = x_hi;
+    other.y_lo = y_lo;
+    other.y_hi = y_hi;
+    other.alloc_x_lo = new_x_lo;
+    other.alloc_x_hi = new_x_hi;
+    other.alloc_y_lo = new_y_lo;
+    other.alloc_y_hi = new_y_hi;
+    other.cells.assign(static_cast<std::size_t>(other.stride()) *
+                           (new_y_hi - new_y_lo),
+                       fill);
+    // copy the grid and its halo
+    for (int y = y_lo - halo; y < y_hi + halo; ++y) {
+        std::ranges::move(padded_row(y),
+                          other.cells.begin() + other.index(x_lo - halo, y));
+    }
+    *this = std::move(other);
 }
 
-// I/O manipulator that reads an 8-bit number into a char instead of a single
-// ASCII character.
 template <typename T>
-class as_number {
-    T &dest;
-    friend std::istream &operator>>(std::istream &is, as_number h) {
-        constexpr bool is_char =
-            std::is_same_v<T, char> || std::is_same_v<T, unsigned char>;
-        if constexpr (is_char) {
-            using int_type =
-                std::conditional_t<std::is_signed_v<T>, short, unsigned short>;
-            int_type temp;
-            is >> temp;
-            // cppcheck-suppress unreadVariable
-            h.dest = static_cast<T>(temp);
+void Grid<T>::expand_to_include(const Pos &pos) {
+    if (in_bounds(pos)) {
+        return;
+    }
+    // an empty dimension doesn't constrain the new bounds
+    const bool has_x = x_lo < x_hi, has_y = y_lo < y_hi;
+    const int new_x_lo = has_x ? std::min(x_lo, pos.x) : pos.x;
+    const int new_x_hi = has_x ? std::max(x_hi, pos.x + 1) : pos.x + 1;
+    const int new_y_lo = has_y ? std::min(y_lo, pos.y) : pos.y;
+    const int new_y_hi = has_y ? std::max(y_hi, pos.y + 1) : pos.y + 1;
+    if (empty()) {
+        // nothing to keep, so allocate exactly what's needed
+        *this = Grid(new_x_hi - new_x_lo, new_y_hi - new_y_lo, fill, halo,
+                     Pos(new_x_lo, new_y_lo));
+        return;
+    }
+    if (new_x_lo - halo < alloc_x_lo || new_x_hi + halo > alloc_x_hi ||
+        new_y_lo - halo < alloc_y_lo || new_y_hi + halo > alloc_y_hi) {
+        // at least double the capacity on any side that's too small
+        int cap_x_lo = alloc_x_lo, cap_x_hi = alloc_x_hi;
+        int cap_y_lo = alloc_y_lo, cap_y_hi = alloc_y_hi;
+        if (new_x_lo - halo < alloc_x_lo) {
+            cap_x_lo = std::min(new_x_lo - halo, alloc_x_lo - width());
+        }
+        if (new_x_hi + halo > alloc_x_hi) {
+            cap_x_hi = std::max(new_x_hi + halo, alloc_x_hi + width());
+        }
+        if (new_y_lo - halo < alloc_y_lo) {
+            cap_y_lo = std::min(new_y_lo - halo, alloc_y_lo - height());
+        }
+        if (new_y_hi + halo > alloc_y_hi) {
+            cap_y_hi = std::max(new_y_hi + halo, alloc_y_hi + height());
+        }
+        reallocate(cap_x_lo, cap_x_hi, cap_y_lo, cap_y_hi);
+    }
+    // Bounds only ever grow, so any cell outside the old halo has never been
+    // written to and still holds the fill value. Cells in the old halo keep
+    // whatever was stored there.
+    x_lo = new_x_lo;
+    x_hi = new_x_hi;
+    y_lo = new_y_lo;
+    y_hi = new_y_hi;
+}
+
+namespace detail {
+// packs both coordinates into a single 64-bit integer
+constexpr std::uint64_t pack_pos(const Pos &pos) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(pos.x))
+               << 32 |
+           static_cast<std::uint32_t>(pos.y);
+}
+
+// splitmix64 finalizer: every input bit affects every output bit, so nearby
+// positions end up spread evenly across the table
+constexpr std::uint64_t mix64(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+constexpr Pos empty_pos{std::numeric_limits<int>::min(),
+                        std::numeric_limits<int>::min()};
+
+inline const Pos &slot_key(const Pos &slot) { return slot; }
+template <typename V>
+inline const Pos &slot_key(const std::pair<Pos, V> &slot) {
+    return slot.first;
+}
+
+/**
+ * Open-addressing hash table keyed by Pos, with linear probing over a
+ * power-of-two number of slots. Empty slots hold empty_pos, so that position
+ * can't be stored. There's no erase, since none of the solutions need it.
+ */
+template <typename Slot>
+class PosTable {
+  protected:
+    std::vector<Slot> slots{};
+    std::size_t count = 0;
+    std::size_t mask = 0;
+
+    static Slot make_empty() {
+        if constexpr (std::is_same_v<Slot, Pos>) {
+            return empty_pos;
         } else {
-            is >> h.dest;
+            return Slot{empty_pos, {}};
         }
-        return is;
+    }
+    static bool is_empty(const Slot &slot) {
+        return slot_key(slot) == empty_pos;
+    }
+
+    // returns the slot containing pos, or the empty slot where it would go
+    std::size_t probe(const Pos &pos) const {
+        std::size_t i = mix64(pack_pos(pos)) & mask;
+        while (!is_empty(slots[i]) && slot_key(slots[i]) != pos) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(std::size_t new_capacity) {
+        std::vector<Slot> old_slots(new_capacity, make_empty());
+        std::swap(slots, old_slots);
+        mask = new_capacity - 1;
+        for (Slot &slot : old_slots) {
+            if (!is_empty(slot)) {
+                slots[probe(slot_key(slot))] = std::move(slot);
+            }
+        }
+    }
+
+    // finds or creates the slot for pos
+    std::pair<std::size_t, bool> find_or_insert(const Pos &pos) {
+        assert(pos != empty_pos);
+        // keep the load factor under 3/4
+        if ((count + 1) * 4 > slots.size() * 3) {
+            rehash(std::max<std::size_t>(16, slots.size() * 2));
+        }
+        std::size_t i = probe(pos);
+        if (!is_empty(slots[i])) {
+            return {i, false};
+        }
+        if constexpr (std::is_same_v<Slot, Pos>) {
+            slots[i] = pos;
+        } else {
+            slots[i].first = pos;
+        }
+        ++count;
+        return {i, true};
     }
 
   public:
-    explicit as_number(T &dest) : dest(dest) {}
+    template <bool is_const>
+    class Iterator {
+        using slot_pointer = std::conditional_t<is_const, const Slot *, Slot *>;
+        slot_pointer ptr = nullptr;
+        slot_pointer end = nullptr;
+
+        void skip_empty() {
+            while (ptr != end && is_empty(*ptr)) {
+                ++ptr;
+            }
+        }
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Slot;
+        using difference_type = std::ptrdiff_t;
+        using pointer = slot_pointer;
+        using reference = std::conditional_t<is_const, const Slot &, Slot &>;
+
+        Iterator() = default;
+        Iterator(slot_pointer ptr, slot_pointer end) : ptr(ptr), end(end) {
+            skip_empty();
+        }
+
+        reference operator*() const { return *ptr; }
+        pointer operator->() const { return ptr; }
+        Iterator &operator++() {
+            ++ptr;
+            skip_empty();
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        bool operator==(const Iterator &other) const {
+            return ptr == other.ptr;
+        }
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool contains(const Pos &pos) const {
+        return count > 0 && !is_empty(slots[probe(pos)]);
+    }
+
+    // make room for n elements without rehashing
+    void reserve(std::size_t n) {
+        std::size_t capacity = 16;
+        while (n * 4 > capacity * 3) {
+            capacity *= 2;
+        }
+        if (capacity > slots.size()) {
+            rehash(capacity);
+        }
+    }
+    // removes all elements, but keeps the allocated slots
+    void clear() {
+        if (count > 0) {
+            std::ranges::fill(slots, make_empty());
+            count = 0;
+        }
+    }
+
+    iterator begin() {
+        return {slots.data(), slots.data() + slots.size()};
+    }
+    iterator end() {
+        return {slots.data() + slots.size(), slots.data() + slots.size()};
+    }
+    const_iterator begin() const {
+        return {slots.data(), slots.data() + slots.size()};
+    }
+    const_iterator end() const {
+        return {slots.data() + slots.size(), slots.data() + slots.size()};
+    }
 };
+} // namespace detail
 
 /**
- * @brief  Parse command line arguments.
- * @return An istream for the specified input file.
+ * @brief  Flat hash set of positions; a drop-in for std::set<Pos> when the
+ *         iteration order doesn't matter.
  */
-std::ifstream parse_args(int argc, char **argv) {
-    if (argc != 2) {
-        assert(argc >= 1);
-        std::cout << "Usage: " << argv[0] << " <input file path>" << std::endl;
-        std::exit(1);
+class PosSet : public detail::PosTable<Pos> {
+  public:
+    PosSet() = default;
+    PosSet(std::initializer_list<Pos> init) {
+        reserve(init.size());
+        for (const Pos &pos : init) {
+            insert(pos);
+        }
+    }
+
+    // returns true if pos was newly inserted
+    bool insert(const Pos &pos) { return find_or_insert(pos).second; }
+};
+
+/**
+ * @brief  Flat hash map from positions to values. Elements are stored as
+ *         std::pair<Pos, V>; don't modify the key through an iterator.
+ */
+template <typename V>
+class PosMap : public detail::PosTable<std::pair<Pos, V>> {
+    using base = detail::PosTable<std::pair<Pos, V>>;
+
+  public:
+    using typename base::const_iterator;
+    using typename base::iterator;
+
+    // default-constructs the value if pos isn't present yet
+    V &operator[](const Pos &pos) {
+        return this->slots[this->find_or_insert(pos).first].second;
+    }
+    iterator find(const Pos &pos) {
+        if (!this->contains(pos)) {
+            return this->end();
+        }
+        auto *slot = this->slots.data() + this->probe(pos);
+        return {slot, this->slots.data() + this->slots.size()};
+    }
+    const_iterator find(const Pos &pos) const {
+        if (!this->contains(pos)) {
+            return this->end();
+        }
+        const auto *slot = this->slots.data() + this->probe(pos);
+        return {slot, this->slots.data() + this->slots.size()};
+    }
+};
+
+namespace detail {
+using bit_word = std::uint64_t;
+
+// Word i of a row after moving every bit dx (-1, 0, or 1) places towards
+// higher x. src[-1] and src[n] must be readable and zero.
+template <int dx>
+inline bit_word shifted_word(const bit_word *src, std::size_t i) {
+    if constexpr (dx > 0) {
+        return src[i] << 1 | src[i - 1] >> 63;
+    } else if constexpr (dx < 0) {
+        return src[i] >> 1 | src[i + 1] << 63;
+    } else {
+        return src[i];
+    }
+}
+
+#ifdef __AVX2__
+inline __m256i load_words(const bit_word *src) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+}
+
+// same as shifted_word(), for words i to i+3
+template <int dx>
+inline __m256i shifted_words(const bit_word *src, std::size_t i) {
+    if constexpr (dx > 0) {
+        return _mm256_or_si256(_mm256_slli_epi64(load_words(src + i), 1),
+                               _mm256_srli_epi64(load_words(src + i - 1), 63));
+    } else if constexpr (dx < 0) {
+        return _mm256_or_si256(_mm256_srli_epi64(load_words(src + i), 1),
+                               _mm256_slli_epi64(load_words(src + i + 1), 63));
+    } else {
+        return load_words(src + i);
+    }
+}
+#endif
+
+// dst[i] = op(dst[i], shifted_word<dx>(src, i)) for a row of n words
+template <int dx, typename Op>
+inline void combine_row(bit_word *dst, const bit_word *src, std::size_t n,
+                        Op op) {
+    std::size_t i = 0;
+#ifdef __AVX2__
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                            op(load_words(dst + i), shifted_words<dx>(src, i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = op(dst[i], shifted_word<dx>(src, i));
+    }
+}
+
+struct bit_copy {
+    bit_word operator()(bit_word, bit_word b) const { return b; }
+#ifdef __AVX2__
+    __m256i operator()(__m256i, __m256i b) const { return b; }
+#endif
+};
+struct bit_and {
+    bit_word operator()(bit_word a, bit_word b) const { return a & b; }
+#ifdef __AVX2__
+    __m256i operator()(__m256i a, __m256i b) const {
+        return _mm256_and_si256(a, b);
+    }
+#endif
+};
+struct bit_or {
+    bit_word operator()(bit_word a, bit_word b) const { return a | b; }
+#ifdef __AVX2__
+    __m256i operator()(__m256i a, __m256i b) const {
+        return _mm256_or_si256(a, b);
+    }
+#endif
+};
+struct bit_xor {
+    bit_word operator()(bit_word a, bit_word b) const { return a ^ b; }
+#ifdef __AVX2__
+    __m256i operator()(__m256i a, __m256i b) const {
+        return _mm256_xor_si256(a, b);
+    }
+#endif
+};
+// a & ~b
+struct bit_and_not {
+    bit_word operator()(bit_word a, bit_word b) const { return a & ~b; }
+#ifdef __AVX2__
+    __m256i operator()(__m256i a, __m256i b) const {
+        // _mm256_andnot_si256 negates its first argument
+        return _mm256_andnot_si256(b, a);
+    }
+#endif
+};
+} // namespace detail
+
+/**
+ * @brief  Fixed-size 2D grid of bits, packed 64 cells to a word.
+ *
+ * Covers the rectangle [0, width) x [0, height). Each row is stored as a run
+ * of uint64_t words, with x increasing from the least significant bit, and
+ * the whole-grid operations (&=, |=, ^=, and_not(), and their *_shifted()
+ * variants) work on a word at a time, or four at a time with AVX2 when it's
+ * enabled at compile time (e.g. with -march=native).
+ *
+ * Rows are separated by a zero word, and any bits past the right edge are
+ * kept at zero, so shifts don't need any special cases at the edges: cells
+ * that are shifted off the grid are dropped, and the cells they leave behind
+ * are cleared.
+ */
+class BitGrid {
+  public:
+    using word_type = detail::bit_word;
+    static constexpr int word_bits = 64;
+
+  private:
+    int num_cols = 0;
+    int num_rows = 0;
+    // number of words holding each row
+    int row_words = 0;
+    // layout: zero, row 0, zero, row 1, ..., row (height - 1), zero
+    std::vector<word_type> words{0};
+
+    int stride() const { return row_words + 1; }
+    word_type *row_data(int y) {
+        return words.data() + 1 + static_cast<std::size_t>(y) * stride();
+    }
+    const word_type *row_data(int y) const {
+        return words.data() + 1 + static_cast<std::size_t>(y) * stride();
+    }
+    // bits of the last word in each row that are inside the grid
+    word_type tail_mask() const {
+        int used = num_cols % word_bits;
+        return used == 0 ? ~word_type{0} : (word_type{1} << used) - 1;
+    }
+    void check_pos(const Pos &pos) const {
+        if constexpr (!aoc::FAST) {
+            assert(in_bounds(pos));
+        }
+    }
+    void check_shape(const BitGrid &other) const {
+        if constexpr (!aoc::FAST) {
+            assert(num_cols == other.num_cols && num_rows == other.num_rows);
+        }
+    }
+
+    template <typename Op>
+    BitGrid &combine(const BitGrid &other, Op op) {
+        check_shape(other);
+        // the padding words are zero in both grids, so they stay zero
+        detail::combine_row<0>(words.data(), other.words.data(), words.size(),
+                               op);
+        return *this;
+    }
+    template <typename Op>
+    BitGrid &combine_shifted(const BitGrid &other, const Delta &delta, Op op);
+
+  public:
+    BitGrid() = default;
+    BitGrid(int width, int height)
+        : num_cols(width), num_rows(height),
+          row_words((width + word_bits - 1) / word_bits),
+          words(1 + static_cast<std::size_t>(height) * (row_words + 1), 0) {
+        assert(width >= 0 && height >= 0);
+    }
+
+    int width() const { return num_cols; }
+    int height() const { return num_rows; }
+    bool in_bounds(const Pos &pos) const {
+        return pos.x >= 0 && pos.x < num_cols && pos.y >= 0 &&
+               pos.y < num_rows;
+    }
+
+    // single-cell access (asserted outside of FAST_MODE)
+    bool test(const Pos &pos) const {
+        check_pos(pos);
+        return row_data(pos.y)[pos.x / word_bits] >> (pos.x % word_bits) & 1;
+    }
+    void set(const Pos &pos, bool value = true) {
+        check_pos(pos);
+        word_type &word = row_data(pos.y)[pos.x / word_bits];
+        word_type bit = word_type{1} << (pos.x % word_bits);
+        word = value ? word | bit : word & ~bit;
+    }
+    void reset(const Pos &pos) { set(pos, false); }
+
+    // The words making up row y. Any bits past width() must be left as 0.
+    std::span<word_type> row(int y) {
+        return {row_data(y), static_cast<std::size_t>(row_words)};
+    }
+    std::span<const word_type> row(int y) const {
+        return {row_data(y), static_cast<std::size_t>(row_words)};
+    }
+
+    // number of set cells
+    int count() const {
+        int total = 0;
+        for (word_type word : words) {
+            total += std::popcount(word);
+        }
+        return total;
+    }
+    bool any() const {
+        return std::ranges::any_of(words, [](word_type w) { return w != 0; });
+    }
+    void clear() { std::ranges::fill(words, 0); }
+
+    // calls func(Pos) for each set cell, in row-major order
+    template <typename Func>
+    void for_each(Func func) const {
+        for (int y = 0; y < num_rows; ++y) {
+            const word_type *data = row_data(y);
+            for (int i = 0; i < row_words; ++i) {
+                for (word_type word = data[i]; word != 0; word &= word - 1) {
+                    func(Pos(i * word_bits + std::countr_zero(word), y));
+                }
+            }
+        }
+    }
+
+    BitGrid &operator&=(const BitGrid &other) {
+        return combine(other, detail::bit_and{});
+    }
+    BitGrid &operator|=(const BitGrid &other) {
+        return combine(other, detail::bit_or{});
+    }
+    BitGrid &operator^=(const BitGrid &other) {
+        return combine(other, detail::bit_xor{});
+    }
+    // clears every cell that's set in other (this &= ~other)
+    BitGrid &and_not(const BitGrid &other) {
+        return combine(other, detail::bit_and_not{});
+    }
+
+    // The same operations with other moved by delta first, in a single pass
+    // (e.g. a |= b.shifted(delta)). The components of delta must be -1, 0, or
+    // 1, which covers all 8 neighbors, and other can't be *this.
+    BitGrid &and_shifted(const BitGrid &other, const Delta &delta) {
+        return combine_shifted(other, delta, detail::bit_and{});
+    }
+    BitGrid &or_shifted(const BitGrid &other, const Delta &delta) {
+        return combine_shifted(other, delta, detail::bit_or{});
+    }
+    BitGrid &xor_shifted(const BitGrid &other, const Delta &delta) {
+        return combine_shifted(other, delta, detail::bit_xor{});
+    }
+    BitGrid &and_not_shifted(const BitGrid &other, const Delta &delta) {
+        return combine_shifted(other, delta, detail::bit_and_not{});
+    }
+
+    // Writes this grid moved by delta into out, so out[pos + delta] =
+    // this[pos]. Cells shifted off the edge are dropped.
+    void shift_into(const Delta &delta, BitGrid &out) const {
+        out.combine_shifted(*this, delta, detail::bit_copy{});
+    }
+    BitGrid shifted(const Delta &delta) const {
+        BitGrid out(num_cols, num_rows);
+        shift_into(delta, out);
+        return out;
+    }
+
+    bool operator==(const BitGrid &) const = default;
+};
+
+template <typename Op>
+BitGrid &BitGrid::combine_shifted(const BitGrid &other, const Delta &delta,
+                                  Op op) {
+    assert(std::abs(delta.dx) <= 1 && std::abs(delta.dy) <= 1);
+    assert(&other != this);
+    check_shape(other);
+    if (row_words == 0) {
+        return *this;
+    }
+    // rows of this grid that have a source row in other
+    const int y_begin = std::max(0, delta.dy);
+    const int y_end = num_rows + std::min(0, delta.dy);
+    // nothing shifts into the first or last row
+    for (int y = 0; y < num_rows; ++y) {
+        if (y < y_begin || y >= y_end) {
+            for (word_type &word : row(y)) {
+                word = op(word, word_type{0});
+            }
+        }
+    }
+    if (y_begin >= y_end) {
+        return *this;
+    }
+    // The zero words between rows supply the bits shifted in at either end of
+    // each row, so all the rows can be processed as a single run.
+    word_type *dst = row_data(y_begin);
+    const word_type *src = other.row_data(y_begin - delta.dy);
+    const auto n = static_cast<std::size_t>(y_end - y_begin) * stride() - 1;
+    if (delta.dx == 0) {
+        detail::combine_row<0>(dst, src, n, op);
+        return *this;
+    }
+    if (delta.dx > 0) {
+        detail::combine_row<1>(dst, src, n, op);
+    } else {
+        detail::combine_row<-1>(dst, src, n, op);
+    }
+    // clear any bits that moved past the edges of a row
+    for (int y = y_begin; y < y_end; ++y) {
+        word_type *data = row_data(y);
+        data[row_words - 1] &= tail_mask();
+        data[row_words] = 0;
+    }
+    return *this;
+}
+
+inline BitGrid operator&(BitGrid lhs, const BitGrid &rhs) {
+    lhs &= rhs;
+    return lhs;
+}
+inline BitGrid operator|(BitGrid lhs, const BitGrid &rhs) {
+    lhs |= rhs;
+    return lhs;
+}
+inline BitGrid operator^(BitGrid lhs, const BitGrid &rhs) {
+    lhs ^= rhs;
+    return lhs;
+}
+
+namespace detail {
+struct never_stop {
+    bool operator()(std::size_t, int) const { return false; }
+};
+} // namespace detail
+
+/**
+ * @brief  Breadth-first search and Dijkstra over nodes numbered from 0 to
+ *         num_nodes - 1, such as the cells of a Grid (see Grid::index_of()).
+ *
+ * The edges come from a callback, neighbors(node, push), which calls
+ * push(next) for each edge out of node in bfs(), or push(next, weight) in
+ * dijkstra(). Any number of sources can be given, and nodes are passed to
+ * visit(node, distance) in order of distance; the search stops early as soon
+ * as that returns true.
+ *
+ * The distance array and queues are kept between searches, and starting a
+ * new search only resets the nodes that the last one reached.
+ */
+class GraphSearch {
+  public:
+    static constexpr int UNREACHED = -1;
+
+  private:
+    std::vector<int> distances{};
+    // every node the current search has reached, in the order they were
+    // first reached (which makes it the queue for bfs())
+    std::vector<std::uint32_t> touched{};
+    // distance in the high half and node in the low half, so entries compare
+    // as single integers
+    std::vector<std::uint64_t> heap{};
+    static std::uint64_t heap_entry(int distance, std::size_t node) {
+        return static_cast<std::uint64_t>(distance) << 32 | node;
+    }
+
+    void start(std::size_t num_nodes);
+    // returns true if the node is new or the distance is an improvement
+    bool relax(std::size_t node, int distance) {
+        int &old_distance = distances[node];
+        if (old_distance == UNREACHED) {
+            touched.push_back(node);
+        } else if (old_distance <= distance) {
+            return false;
+        }
+        old_distance = distance;
+        return true;
+    }
+
+  public:
+    // whether the last search reached node (for dijkstra(), with its final
+    // distance only if it was visited)
+    bool reached(std::size_t node) const {
+        return distance(node) != UNREACHED;
+    }
+    int distance(std::size_t node) const {
+        return node < distances.size() ? distances[node] : UNREACHED;
+    }
+
+    // Returns the node where visit() stopped the search, if it did.
+    template <typename Sources, typename Neighbors,
+              typename Visit = detail::never_stop>
+    std::optional<std::size_t> bfs(std::size_t num_nodes,
+                                   const Sources &sources, Neighbors neighbors,
+                                   Visit visit = {});
+    template <typename Neighbors, typename Visit = detail::never_stop>
+    std::optional<std::size_t> bfs(std::size_t num_nodes,
+                                   std::initializer_list<std::size_t> sources,
+                                   Neighbors neighbors, Visit visit = {}) {
+        return bfs<std::initializer_list<std::size_t>>(num_nodes, sources,
+                                                       neighbors, visit);
+    }
+
+    // Edge weights must be non-negative.
+    template <typename Sources, typename Neighbors,
+              typename Visit = detail::never_stop>
+    std::optional<std::size_t> dijkstra(std::size_t num_nodes,
+                                        const Sources &sources,
+                                        Neighbors neighbors, Visit visit = {});
+    template <typename Neighbors, typename Visit = detail::never_stop>
+    std::optional<std::size_t>
+    dijkstra(std::size_t num_nodes, std::initializer_list<std::size_t> sources,
+             Neighbors neighbors, Visit visit = {}) {
+        return dijkstra<std::initializer_list<std::size_t>>(
+            num_nodes, sources, neighbors, visit);
+    }
+};
+
+inline void GraphSearch::start(std::size_t num_nodes) {
+    assert(num_nodes <= std::numeric_limits<std::uint32_t>::max());
+    for (std::uint32_t node : touched) {
+        distances[node] = UNREACHED;
+    }
+    touched.clear();
+    heap.clear();
+    if (distances.size() < num_nodes) {
+        distances.resize(num_nodes, UNREACHED);
+        touched.reserve(num_nodes);
+    }
+}
+
+template <typename Sources, typename Neighbors, typename Visit>
+std::optional<std::size_t> GraphSearch::bfs(std::size_t num_nodes,
+                                            const Sources &sources,
+                                            Neighbors neighbors, Visit visit) {
+    start(num_nodes);
+    for (std::size_t source : sources) {
+        relax(source, 0);
+    }
+    // every node is added at most once, and in order of distance
+    for (std::size_t head = 0; head < touched.size(); ++head) {
+        const std::size_t node = touched[head];
+        const int distance = distances[node];
+        if (visit(node, distance)) {
+            return node;
+        }
+        neighbors(node, [&](std::size_t next) {
+            if (distances[next] == UNREACHED) {
+                distances[next] = distance + 1;
+                touched.push_back(next);
+            }
+        });
+    }
+    return std::nullopt;
+}
+
+template <typename Sources, typename Neighbors, typename Visit>
+std::optional<std::size_t>
+GraphSearch::dijkstra(std::size_t num_nodes, const Sources &sources,
+                      Neighbors neighbors, Visit visit) {
+    start(num_nodes);
+    // min-heap on distance
+    constexpr auto cmp = std::greater<>{};
+    for (std::size_t source : sources) {
+        if (relax(source, 0)) {
+            heap.push_back(heap_entry(0, source));
+        }
+    }
+    while (!heap.empty()) {
+        std::ranges::pop_heap(heap, cmp);
+        const int distance = heap.back() >> 32;
+        const std::size_t node = heap.back() & 0xffff'ffff;
+        heap.pop_back();
+        if (distance > distances[node]) {
+            // stale entry, since the node was pushed again when it improved
+            continue;
+        }
+        if (visit(node, distance)) {
+            return node;
+        }
+        neighbors(node, [&](std::size_t next, int weight) {
+            assert(weight >= 0);
+            if (relax(next, distance + weight)) {
+                heap.push_back(heap_entry(distance + weight, next));
+                std::ranges::push_heap(heap, cmp);
+            }
+        });
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief  Unit-weight search over a BitGrid that advances the whole frontier
+ *         a layer at a time, using BitGrid's word-parallel shifts.
+ *
+ * Each step, the next frontier is the union of the current one moved by each
+ * of `moves` (include Delta(0, 0) to allow waiting in place), masked by
+ * open(layer), which returns the BitGrid of cells that can be occupied at
+ * that layer. This suits searches where the obstacles change over time, or
+ * where the frontier covers much of the grid; it does the same work per
+ * layer no matter how small the frontier is.
+ */
+class FrontierSearch {
+    // the next layer, kept between steps and searches
+    BitGrid next{};
+
+  public:
+    // Advances frontier until done(frontier, layer) returns true, and
+    // returns that layer; returns nullopt if the frontier dies out first.
+    template <typename Open, typename Done>
+    std::optional<int> run(BitGrid &frontier, std::span<const Delta> moves,
+                           Open open, Done done);
+};
+
+template <typename Open, typename Done>
+std::optional<int> FrontierSearch::run(BitGrid &frontier,
+                                       std::span<const Delta> moves, Open open,
+                                       Done done) {
+    assert(!moves.empty());
+    if (next.width() != frontier.width() ||
+        next.height() != frontier.height()) {
+        next = BitGrid(frontier.width(), frontier.height());
+    }
+    for (int layer = 0;; ++layer) {
+        if (done(std::as_const(frontier), layer)) {
+            return layer;
+        }
+        if (!frontier.any()) {
+            return std::nullopt;
+        }
+        frontier.shift_into(moves[0], next);
+        for (const Delta &delta : moves.subspan(1)) {
+            next.or_shifted(frontier, delta);
+        }
+        next &= open(layer + 1);
+        std::swap(frontier, next);
+    }
+}
+
+/**
+ * @brief  Monotonic bump allocator for objects that all live until the end
+ *         of a phase.
+ *
+ * Memory is carved out of a chain of blocks that double in size, and is only
+ * released when the arena is reset() or destroyed. Objects created with
+ * make<T>() have their destructors run at that point, in reverse order of
+ * creation (trivially destructible types cost nothing extra).
+ *
+ * Arena is also a std::pmr::memory_resource, so standard containers can put
+ * their nodes in it (e.g. std::pmr::map<Pos, int> m{&arena}). Deallocation
+ * is a no-op, so this is best suited to containers that only grow.
+ *
+ * Pointers into the arena stay valid until it's reset, so it can't be copied
+ * or moved.
+ */
+class Arena : public std::pmr::memory_resource {
+    // stored at the start of each block
+    struct Block {
+        Block *prev;
+    };
+    // destructor to run on reset, allocated right after its object
+    struct Cleanup {
+        Cleanup *prev;
+        void (*destroy)(void *);
+        void *object;
+    };
+
+    std::size_t initial_block_size;
+    std::size_t next_block_size;
+    Block *blocks = nullptr;
+    Cleanup *cleanups = nullptr;
+    std::byte *cursor = nullptr;
+    std::byte *limit = nullptr;
+
+    // allocates a new block big enough for the request, then retries
+    void *allocate_slow(std::size_t bytes, std::size_t alignment);
+
+    void *bump(std::size_t bytes, std::size_t alignment) {
+        std::size_t padding =
+            -reinterpret_cast<std::uintptr_t>(cursor) & (alignment - 1);
+        if (padding + bytes > static_cast<std::size_t>(limit - cursor)) {
+            return allocate_slow(bytes, alignment);
+        }
+        void *result = cursor + padding;
+        cursor += padding + bytes;
+        return result;
+    }
+
+  protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        return bump(bytes, alignment);
+    }
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const
+        noexcept override {
+        return this == &other;
+    }
+
+  public:
+    explicit Arena(std::size_t block_size = 4096)
+        : initial_block_size(block_size), next_block_size(block_size) {}
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    ~Arena() override { reset(); }
+
+    // constructs a T in the arena; it's destroyed when the arena is reset
+    template <typename T, typename... Args>
+    T *make(Args &&...args) {
+        T *object = ::new (bump(sizeof(T), alignof(T)))
+            T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            void *mem = bump(sizeof(Cleanup), alignof(Cleanup));
+            cleanups = ::new (mem) Cleanup{
+                cleanups, [](void *p) { static_cast<T *>(p)->~T(); },
+                object};
+        }
+        return object;
+    }
+
+    // destroys everything made in the arena and releases all the memory
+    void reset();
+};
+
+inline void *Arena::allocate_slow(std::size_t bytes, std::size_t alignment) {
+    std::size_t needed = sizeof(Block) + bytes + alignment;
+    std::size_t size = std::max(next_block_size, needed);
+    auto *block = static_cast<Block *>(::operator new(size));
+    block->prev = blocks;
+    blocks = block;
+    cursor = reinterpret_cast<std::byte *>(block + 1);
+    limit = reinterpret_cast<std::byte *>(block) + size;
+    next_block_size *= 2;
+    return bump(bytes, alignment);
+}
+
+inline void Arena::reset() {
+    for (; cleanups != nullptr; cleanups = cleanups->prev) {
+        cleanups->destroy(cleanups->object);
+    }
+    while (blocks != nullptr) {
+        Block *prev = blocks->prev;
+        ::operator delete(blocks);
+        blocks = prev;
+    }
+    cursor = limit = nullptr;
+    next_block_size = initial_block_size;
+}
+
+// use an anonymous namespace to hide this implementation detail
+namespace {
+template <typename T>
+struct SkipInputHelper {
+    int count;
+    friend std::istream &operator>>(std::istream &is, SkipInputHelper s) {
+        T temp;
+        for (int i = 0; i < s.count && (is >> temp); ++i)
+            ;
+        return is;
+    }
+};
+} // namespace
+
+template <typename T = std::string>
+SkipInputHelper<T> skip(int count = 1) {
+    return SkipInputHelper<T>{count};
+}
+
+// I/O manipulator that reads an 8-bit number into a char instead of a single
+// ASCII character.
+template <typename T>
+class as_number {
+    T &dest;
+    friend std::istream &operator>>(std::istream &is, as_number h) {
+        constexpr bool is_char =
+            std::is_same_v<T, char> || std::is_same_v<T, unsigned char>;
+        if constexpr (is_char) {
+            using int_type =
+                std::conditional_t<std::is_signed_v<T>, short, unsigned short>;
+            int_type temp;
+            is >> temp;
+            // cppcheck-suppress unreadVariable
+            h.dest = static_cast<T>(temp);
+        } else {
+            is >> h.dest;
+        }
+        return is;
+    }
+
+  public:
+    explicit as_number(T &dest) : dest(dest) {}
+};
+
+/**
+ * @brief  Non-allocating scanner over a block of text.
+ *
+ * A lightweight replacement for operator>> with skip() and as_number: tokens
+ * are returned as views into the original buffer, and integers are parsed
+ * with std::from_chars. Like an istream, any failed read puts the scanner
+ * into a failed state, which is checked with operator bool.
+ */
+class Scanner {
+    const char *pos;
+    const char *end;
+    bool failed = false;
+
+    // same set as std::isspace in the C locale, without the function call
+    static bool is_space(char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+  public:
+    explicit Scanner(std::string_view text)
+        : pos(text.data()), end(text.data() + text.size()) {}
+
+    explicit operator bool() const { return !failed; }
+    bool fail() const { return failed; }
+    // returns true if there's nothing left but whitespace
+    bool at_end() {
+        skip_ws();
+        return pos == end;
+    }
+    std::string_view rest() const { return {pos, end}; }
+
+    Scanner &skip_ws() {
+        while (pos != end && is_space(*pos)) {
+            ++pos;
+        }
+        return *this;
+    }
+
+    // reads an integer after any leading whitespace (a leading '+' is not
+    // accepted, same as from_chars)
+    template <typename T = int>
+    T next_int() {
+        static_assert(std::is_integral_v<T>, "next_int requires an integer");
+        T value{};
+        skip_ws();
+        auto [ptr, ec] = std::from_chars(pos, end, value);
+        if (ec != std::errc{}) {
+            failed = true;
+            return T{};
+        }
+        pos = ptr;
+        return value;
+    }
+
+    // returns the next whitespace-delimited token
+    std::string_view next_token() {
+        skip_ws();
+        const char *start = pos;
+        while (pos != end && !is_space(*pos)) {
+            ++pos;
+        }
+        if (start == pos) {
+            failed = true;
+        }
+        return {start, pos};
+    }
+
+    // returns the next non-whitespace character
+    char next_char() {
+        skip_ws();
+        if (pos == end) {
+            failed = true;
+            return '\0';
+        }
+        return *pos++;
+    }
+
+    // consumes the next non-whitespace character only if it equals c
+    bool consume(char c) {
+        skip_ws();
+        if (pos != end && *pos == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    // advances to just past the next occurrence of c
+    Scanner &skip_until(char c) {
+        while (pos != end && *pos != c) {
+            ++pos;
+        }
+        if (pos == end) {
+            failed = true;
+        } else {
+            ++pos;
+        }
+        return *this;
+    }
+
+    // skips count whitespace-delimited tokens
+    Scanner &skip_tokens(int count = 1) {
+        for (int i = 0; i < count && !failed; ++i) {
+            next_token();
+        }
+        return *this;
+    }
+};
+
+/**
+ * @brief  The pieces of some text between each occurrence of a delimiter, as
+ *         views into the text. Made by lines() and split().
+ */
+class SplitView : public std::ranges::view_interface<SplitView> {
+    std::string_view text;
+    char delim;
+    // like std::getline, a delimiter at the very end doesn't start another
+    // (empty) piece
+    bool drop_trailing_empty;
+
+  public:
+    class iterator {
+        std::string_view piece{};
+        // start of the next piece, or nullptr if this is the last one
+        const char *next = nullptr;
+        const char *end = nullptr;
+        char delim = '\n';
+        bool drop_trailing_empty = false;
+        bool done = true;
+
+        void find_piece(const char *start) {
+            const void *found = std::memchr(start, delim, end - start);
+            if (found == nullptr) {
+                piece = {start, end};
+                next = nullptr;
+                return;
+            }
+            piece = {start, static_cast<const char *>(found)};
+            next = piece.data() + piece.size() + 1;
+            if (next == end && drop_trailing_empty) {
+                next = nullptr;
+            }
+        }
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = const std::string_view &;
+
+        iterator() = default;
+        iterator(std::string_view text, char delim, bool drop_trailing_empty)
+            : end(text.data() + text.size()), delim(delim),
+              drop_trailing_empty(drop_trailing_empty), done(text.empty()) {
+            if (!done) {
+                find_piece(text.data());
+            }
+        }
+
+        reference operator*() const { return piece; }
+        pointer operator->() const { return &piece; }
+
+        iterator &operator++() {
+            if (next == nullptr) {
+                done = true;
+            } else {
+                find_piece(next);
+            }
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator &other) const {
+            if (done || other.done) {
+                return done == other.done;
+            }
+            return piece.data() == other.piece.data();
+        }
+    };
+
+    SplitView(std::string_view text, char delim, bool drop_trailing_empty)
+        : text(text), delim(delim), drop_trailing_empty(drop_trailing_empty) {}
+
+    iterator begin() const { return {text, delim, drop_trailing_empty}; }
+    iterator end() const { return {}; }
+};
+
+/**
+ * @brief  The lines of some text, without their newlines; a replacement for
+ *         a std::getline loop that doesn't copy anything.
+ */
+inline SplitView lines(std::string_view text) {
+    return SplitView{text, '\n', true};
+}
+
+/**
+ * @brief  The fields of some text separated by `delim`. Unlike lines(), a
+ *         trailing delimiter gives an empty last field.
+ */
+inline SplitView split(std::string_view text, char delim) {
+    return SplitView{text, delim, false};
+}
+
+/**
+ * @brief  Split some text around the first occurrence of `delim`.
+ * @return The parts before and after the delimiter, or the whole text and an
+ *         empty view if it doesn't occur.
+ */
+inline std::pair<std::string_view, std::string_view>
+split_once(std::string_view text, std::string_view delim) {
+    const std::size_t index = text.find(delim);
+    if (index == std::string_view::npos) {
+        return {text, {}};
+    }
+    return {text.substr(0, index), text.substr(index + delim.size())};
+}
+
+/**
+ * @brief  Parse all of `text` as an integer, with std::from_chars.
+ * @throws std::invalid_argument if it isn't exactly one integer.
+ */
+template <typename T = int>
+T parse_int(std::string_view text) {
+    static_assert(std::is_integral_v<T>, "parse_int requires an integer");
+    T value{};
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) {
+        throw std::invalid_argument("not an integer: " + std::string{text});
+    }
+    return value;
+}
+
+// streambuf that reads directly out of an existing buffer, without copying
+class ViewStreamBuf : public std::streambuf {
+  public:
+    explicit ViewStreamBuf(std::string_view sv) {
+        // the get area is never written to, so casting away const is safe
+        char *begin = const_cast<char *>(sv.data());
+        setg(begin, begin, begin + sv.size());
+    }
+
+  protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        off_type base = 0;
+        if (dir == std::ios_base::cur) {
+            base = gptr() - eback();
+        } else if (dir == std::ios_base::end) {
+            base = egptr() - eback();
+        }
+        off_type new_pos = base + off;
+        if (new_pos < 0 || new_pos > egptr() - eback()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + new_pos, egptr());
+        return pos_type(new_pos);
+    }
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+/**
+ * @brief  Cursor over a block of input text owned by someone else.
+ *
+ * `next_line()` walks a byte cursor over the text without allocating. Days
+ * that still parse with operator>> can read from `stream()` instead, which
+ * shares the same buffer.
+ */
+class InputView {
+    std::string_view text;
+    std::size_t cursor = 0;
+    ViewStreamBuf buf;
+    std::istream is;
+
+  public:
+    explicit InputView(std::string_view text)
+        : text(text), buf(text), is(&buf) {}
+    // the stream holds a pointer to buf, so this can't be copied or moved
+    InputView(const InputView &) = delete;
+    InputView &operator=(const InputView &) = delete;
+
+    const char *data() const { return text.data(); }
+    std::size_t size() const { return text.size(); }
+    std::string_view view() const { return text; }
+
+    // byte cursor used by next_line(); independent of stream()
+    std::size_t tell() const { return cursor; }
+    void seek(std::size_t pos) {
+        assert(pos <= size());
+        cursor = pos;
+    }
+    bool eof() const { return cursor >= size(); }
+    // everything from the cursor to the end of the text
+    std::string_view rest() const { return text.substr(cursor); }
+
+    // Works like std::getline: returns false once the input is exhausted, and
+    // strips the trailing newline. The view points into the original text.
+    bool next_line(std::string_view &line) {
+        if (eof()) {
+            return false;
+        }
+        const std::string_view remaining = rest();
+        std::size_t len = remaining.find('\n');
+        if (len == std::string_view::npos) {
+            len = remaining.size();
+            cursor = size();
+        } else {
+            cursor += len + 1;
+        }
+        line = remaining.substr(0, len);
+        if constexpr (!aoc::FAST) {
+            assert(cursor <= size());
+        }
+        return true;
+    }
+
+    // istream over the text, for parsers built on operator>>
+    std::istream &stream() { return is; }
+};
+
+namespace detail {
+// maps a whole file read-only; empty files give an empty view
+inline std::string_view map_file(const std::string &filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == -1) {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), filename);
+    }
+    std::size_t size = st.st_size;
+    if (size == 0) {
+        // mmap doesn't accept empty mappings
+        ::close(fd);
+        return {"", 0};
+    }
+    void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw std::system_error(err, std::generic_category(), filename);
+    }
+    // we (almost) always read front to back, so let the kernel read ahead
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+    return {static_cast<const char *>(addr), size};
+}
+
+inline void unmap_file(std::string_view contents) {
+    if (!contents.empty()) {
+        ::munmap(const_cast<char *>(contents.data()), contents.size());
+    }
+}
+
+// paths of the files that are currently mapped by a MappedInput, by address,
+// so InputCache can find the file a solution's text came from
+inline std::map<const char *, std::string> &mapped_inputs() {
+    static std::map<const char *, std::string> mapped_inputs{};
+    return mapped_inputs;
+}
+} // namespace detail
+
+/**
+ * @brief  Read-only memory mapping of an input file, with the same cursor
+ *         and stream as InputView.
+ */
+class MappedInput : public InputView {
+    struct from_mapping_t {};
+    MappedInput(from_mapping_t, std::string_view contents,
+                const std::string &filename)
+        : InputView(contents) {
+        if (size() > 0) {
+            detail::mapped_inputs()[data()] = filename;
+        }
+    }
+
+  public:
+    explicit MappedInput(const std::string &filename)
+        : MappedInput(from_mapping_t{}, detail::map_file(filename), filename) {
+    }
+    ~MappedInput() {
+        if (size() > 0) {
+            detail::mapped_inputs().erase(data());
+        }
+        detail::unmap_file(view());
+    }
+};
+
+namespace {
+void check_args(int argc, char **argv) {
+    if (argc != 2) {
+        assert(argc >= 1);
+        std::cout << "Usage: " << argv[0] << " <input file path>" << std::endl;
+        std::exit(1);
+    }
+}
+} // namespace
+
+/**
+ * @brief  Parse command line arguments.
+ * @return An istream for the specified input file.
+ */
+inline std::ifstream parse_args(int argc, char **argv) {
+    check_args(argc, argv);
+    return std::ifstream{argv[1]};
+}
+
+/**
+ * @brief  Parse command line arguments, and map the input file into memory.
+ * @return A MappedInput for the specified input file.
+ */
+inline MappedInput map_input(int argc, char **argv) {
+    check_args(argc, argv);
+    return MappedInput{argv[1]};
+}
+
+/*
+ * Opt-in cache of a day's parsed input, for rerunning the same input many
+ * times (mostly while benchmarking). A day saves its parsed records into a
+ * binary file next to the input (input/dayNN/input.txt.cache), and later runs
+ * map that file and use the records in place instead of parsing the text
+ * again. Set AOC_INPUT_CACHE=1 in the environment to enable it.
+ *
+ * The file holds a header, a table of sections, and then each section's
+ * records, which must be trivially copyable. A cache is only used if it's
+ * newer than the input, has the same day and format version, and was made
+ * from an input of the same size; otherwise it's ignored and rewritten.
+ * Bump a day's version whenever the layout of its records changes. The
+ * format is native-endian, and only meant for the machine that wrote it.
+ */
+namespace detail {
+struct CacheHeader {
+    std::array<char, 8> magic;
+    std::uint32_t day;
+    std::uint32_t version;
+    std::uint64_t input_size;
+    std::uint64_t num_sections;
+};
+
+struct CacheSection {
+    std::uint64_t offset;
+    std::uint64_t count;
+    std::uint64_t record_size;
+};
+
+constexpr std::array<char, 8> CACHE_MAGIC{'A', 'O', 'C', 'C',
+                                          'A', 'C', 'H', 'E'};
+// every section starts on a cache line
+constexpr std::size_t CACHE_ALIGNMENT = 64;
+
+inline bool input_cache_enabled() {
+    static const bool enabled = [] {
+        const char *value = std::getenv("AOC_INPUT_CACHE");
+        return value != nullptr && *value != '\0' &&
+               std::string_view{value} != "0";
+    }();
+    return enabled;
+}
+
+// the file that `text` was mapped from, if it's a whole MappedInput
+inline std::optional<std::string> mapped_input_path(std::string_view text) {
+    const auto &inputs = mapped_inputs();
+    auto it = inputs.find(text.data());
+    if (text.empty() || it == inputs.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+} // namespace detail
+
+/**
+ * @brief  A valid, memory-mapped input cache; see InputCacheWriter.
+ */
+class InputCache {
+    std::string_view contents;
+    std::span<const detail::CacheSection> sections{};
+
+    explicit InputCache(std::string_view contents) : contents(contents) {}
+
+  public:
+    /**
+     * @brief  Map the cache for a day's input text, if caching is enabled
+     *         and there's an up-to-date cache for it.
+     */
+    static std::optional<InputCache> load(std::string_view text, int day,
+                                          std::uint32_t version);
+
+    InputCache(InputCache &&other) noexcept
+        : contents(std::exchange(other.contents, {})),
+          sections(std::exchange(other.sections, {})) {}
+    InputCache &operator=(InputCache &&) = delete;
+    ~InputCache() { detail::unmap_file(contents); }
+
+    /**
+     * @brief  The records in a section, in place in the mapping.
+     */
+    template <typename T>
+    std::span<const T> section(std::size_t index) const {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (index >= sections.size() ||
+            sections[index].record_size != sizeof(T)) {
+            throw std::logic_error(
+                "input cache layout changed without a version bump");
+        }
+        return {reinterpret_cast<const T *>(contents.data() +
+                                            sections[index].offset),
+                sections[index].count};
+    }
+};
+
+inline std::optional<InputCache>
+InputCache::load(std::string_view text, int day, std::uint32_t version) {
+    if (!detail::input_cache_enabled()) {
+        return std::nullopt;
+    }
+    const std::optional<std::string> input_path =
+        detail::mapped_input_path(text);
+    if (!input_path) {
+        return std::nullopt;
+    }
+    const std::string path = *input_path + ".cache";
+    struct stat input_st, cache_st;
+    if (::stat(input_path->c_str(), &input_st) == -1 ||
+        ::stat(path.c_str(), &cache_st) == -1) {
+        return std::nullopt;
+    }
+    if (cache_st.st_mtim.tv_sec < input_st.st_mtim.tv_sec ||
+        (cache_st.st_mtim.tv_sec == input_st.st_mtim.tv_sec &&
+         cache_st.st_mtim.tv_nsec < input_st.st_mtim.tv_nsec)) {
+        return std::nullopt;
+    }
+    std::optional<InputCache> cache{};
+    try {
+        cache.emplace(InputCache{detail::map_file(path)});
+    } catch (const std::system_error &) {
+        return std::nullopt;
+    }
+    // check everything before trusting any offsets
+    const std::string_view contents = cache->contents;
+    detail::CacheHeader header;
+    if (contents.size() < sizeof(header)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if (header.magic != detail::CACHE_MAGIC ||
+        header.day != static_cast<std::uint32_t>(day) ||
+        header.version != version || header.input_size != text.size() ||
+        header.num_sections >
+            (contents.size() - sizeof(header)) / sizeof(detail::CacheSection)) {
+        return std::nullopt;
+    }
+    cache->sections = {reinterpret_cast<const detail::CacheSection *>(
+                           contents.data() + sizeof(header)),
+                       header.num_sections};
+    for (const detail::CacheSection &section : cache->sections) {
+        if (section.offset % detail::CACHE_ALIGNMENT != 0 ||
+            section.offset > contents.size() || section.record_size == 0 ||
+            section.count >
+                (contents.size() - section.offset) / section.record_size) {
+            return std::nullopt;
+        }
+    }
+    return cache;
+}
+
+/**
+ * @brief  Collects a day's parsed records, and writes them out as the cache
+ *         for its input.
+ */
+class InputCacheWriter {
+    std::vector<detail::CacheSection> sections{};
+    std::vector<std::string> payloads{};
+
+  public:
+    /**
+     * @brief  Add the next section. Sections are read back by index, in the
+     *         order they were added.
+     */
+    template <std::ranges::contiguous_range R>
+    InputCacheWriter &add(const R &records) {
+        using T = std::ranges::range_value_t<R>;
+        static_assert(std::is_trivially_copyable_v<T>);
+        sections.push_back({0, std::ranges::size(records), sizeof(T)});
+        payloads.emplace_back(
+            reinterpret_cast<const char *>(std::ranges::data(records)),
+            std::ranges::size(records) * sizeof(T));
+        return *this;
+    }
+
+    /**
+     * @brief  Write the cache for a day's input text, if caching is enabled.
+     *
+     * Failing to write the cache isn't fatal, since it's only an
+     * optimization.
+     */
+    void save(std::string_view text, int day, std::uint32_t version);
+};
+
+inline void InputCacheWriter::save(std::string_view text, int day,
+                                   std::uint32_t version) {
+    if (!detail::input_cache_enabled()) {
+        return;
+    }
+    const std::optional<std::string> input_path =
+        detail::mapped_input_path(text);
+    if (!input_path) {
+        return;
+    }
+    const std::string path = *input_path + ".cache";
+    auto align = [](std::size_t offset) {
+        return (offset + detail::CACHE_ALIGNMENT - 1) /
+               detail::CACHE_ALIGNMENT * detail::CACHE_ALIGNMENT;
+    };
+    detail::CacheHeader header{detail::CACHE_MAGIC,
+                               static_cast<std::uint32_t>(day), version,
+                               text.size(), sections.size()};
+    std::size_t offset = align(sizeof(header) +
+                               sections.size() * sizeof(detail::CacheSection));
+    for (detail::CacheSection &section : sections) {
+        section.offset = offset;
+        offset = align(offset + section.count * section.record_size);
+    }
+    std::string buffer(offset, '\0');
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(header), sections.data(),
+                sections.size() * sizeof(detail::CacheSection));
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        std::ranges::copy(payloads[i], buffer.begin() + sections[i].offset);
+    }
+    // write to a temporary file and rename it, so readers never see a
+    // partial cache
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream os{tmp_path, std::ios::binary};
+        os.write(buffer.data(), buffer.size());
+        if (!os) {
+            std::cerr << "warning: could not write input cache " << tmp_path
+                      << "\n";
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) == -1) {
+        std::cerr << "warning: could not write input cache " << path << "\n";
+        std::remove(tmp_path.c_str());
+    }
+}
+
+/*
+ * Hot-path instrumentation: AOC_TIMER("name") times the rest of the enclosing
+ * scope, and AOC_COUNTER("name", n) adds n to a counter. Both aggregate by
+ * name over the whole run, and the drivers print a report to stderr after
+ * each day. They compile to nothing in the fast build (but not the profile
+ * build), so they can stay in the solvers.
+ */
+#if !defined(FAST_MODE) || defined(PROFILE_MODE)
+#define AOC_INSTRUMENT 1
+#endif
+
+namespace instrument {
+#ifdef AOC_INSTRUMENT
+[[maybe_unused]] constexpr bool ENABLED = true;
+#else
+[[maybe_unused]] constexpr bool ENABLED = false;
+#endif
+
+// the values are atomic, since solutions may count from several threads
+struct TimerStats {
+    std::atomic<long> calls = 0;
+    std::atomic<std::chrono::steady_clock::rep> total_ticks = 0;
+};
+
+// entries are never removed, since each call site keeps a reference to its own
+inline std::map<std::string_view, std::atomic<long>> &counters() {
+    static std::map<std::string_view, std::atomic<long>> counters{};
+    return counters;
+}
+
+inline std::map<std::string_view, TimerStats> &timers() {
+    static std::map<std::string_view, TimerStats> timers{};
+    return timers;
+}
+
+// guards insertions into counters() and timers()
+inline std::mutex &registry_mutex() {
+    static std::mutex mutex{};
+    return mutex;
+}
+
+inline std::atomic<long> &counter(std::string_view name) {
+    std::lock_guard lock{registry_mutex()};
+    return counters()[name];
+}
+
+inline TimerStats &timer(std::string_view name) {
+    std::lock_guard lock{registry_mutex()};
+    return timers()[name];
+}
+
+class ScopedTimer {
+    TimerStats &stats;
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    explicit ScopedTimer(TimerStats &stats)
+        : stats(stats), start(std::chrono::steady_clock::now()) {}
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+    ~ScopedTimer() {
+        stats.calls.fetch_add(1, std::memory_order_relaxed);
+        stats.total_ticks.fetch_add(
+            (std::chrono::steady_clock::now() - start).count(),
+            std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief  Write out all the counters and timers that were hit since the last
+ *         reset(), if there are any.
+ */
+inline void report(std::ostream &os) {
+    std::size_t width = 0;
+    for (const auto &[name, value] : counters()) {
+        if (value != 0) {
+            width = std::max(width, name.size());
+        }
+    }
+    for (const auto &[name, stats] : timers()) {
+        if (stats.calls != 0) {
+            width = std::max(width, name.size());
+        }
+    }
+    if (width == 0) {
+        return;
+    }
+    os << "instrumentation:\n";
+    for (const auto &[name, value] : counters()) {
+        if (value != 0) {
+            os << "  " << std::left << std::setw(width) << name << std::right
+               << std::setw(16) << value.load() << "\n";
+        }
+    }
+    for (const auto &[name, stats] : timers()) {
+        if (stats.calls != 0) {
+            std::chrono::duration<double, std::milli> total =
+                std::chrono::steady_clock::duration{stats.total_ticks};
+            os << "  " << std::left << std::setw(width) << name << std::right
+               << std::setw(16) << std::fixed << std::setprecision(3)
+               << total.count() << " ms in " << stats.calls << " calls\n";
+            os.unsetf(std::ios_base::floatfield);
+        }
+    }
+}
+
+inline void reset() {
+    for (auto &[name, value] : counters()) {
+        value = 0;
+    }
+    for (auto &[name, stats] : timers()) {
+        stats.calls = 0;
+        stats.total_ticks = 0;
+    }
+}
+} // namespace instrument
+
+#define AOC_CONCAT_IMPL(a, b) a##b
+#define AOC_CONCAT(a, b) AOC_CONCAT_IMPL(a, b)
+
+#ifdef AOC_INSTRUMENT
+#define AOC_TIMER(name)                                                        \
+    static ::aoc::instrument::TimerStats &AOC_CONCAT(aoc_timer_stats_,        \
+                                                     __LINE__) =               \
+        ::aoc::instrument::timer(name);                                        \
+    const ::aoc::instrument::ScopedTimer AOC_CONCAT(aoc_timer_, __LINE__) {    \
+        AOC_CONCAT(aoc_timer_stats_, __LINE__)                                 \
+    }
+#define AOC_COUNTER(name, n)                                                   \
+    do {                                                                       \
+        static std::atomic<long> &aoc_counter_ =                               \
+            ::aoc::instrument::counter(name);                                  \
+        aoc_counter_.fetch_add((n), std::memory_order_relaxed);                \
+    } while (0)
+#else
+#define AOC_TIMER(name) static_cast<void>(0)
+#define AOC_COUNTER(name, n) static_cast<void>(0)
+#endif
+
+/**
+ * @brief  Allocation accounting for the alloc build (`make alloc`).
+ *
+ * That build links in alloc_hooks.cpp, which replaces the global operator
+ * new and delete to count allocations, bytes, and peak live bytes for the
+ * parse and solve phases of each solution, and to bucket them by call site.
+ * Everywhere else these are no-ops.
+ */
+namespace alloc {
+#ifdef ALLOC_MODE
+[[maybe_unused]] constexpr bool ENABLED = true;
+// these are defined in alloc_hooks.cpp
+// resets the statistics and starts the parse phase
+void begin_solve();
+// starts the solve phase
+void mark_parsed();
+void end_solve();
+// writes out the statistics since the last begin_solve()
+void report(std::ostream &os);
+#else
+[[maybe_unused]] constexpr bool ENABLED = false;
+inline void begin_solve() {}
+inline void mark_parsed() {}
+inline void end_solve() {}
+inline void report(std::ostream &) {}
+#endif
+} // namespace alloc
+
+/**
+ * @brief  A small work-stealing thread pool.
+ *
+ * Each worker has its own deque of tasks: it pushes and pops at the back, so
+ * it works depth-first on what it just spawned, and idle workers steal the
+ * oldest tasks from the front of the others'. Threads outside the pool share
+ * one more deque. A thread waiting on a TaskGroup runs queued tasks instead
+ * of blocking, so groups can nest.
+ *
+ * A pool with one thread has no workers, and runs every task inline as soon
+ * as it's submitted. That's the deterministic mode for debugging, and the
+ * default in debug builds; AOC_THREADS=N in the environment overrides the
+ * size of the global pool.
+ */
+class ThreadPool {
+  public:
+    // must be copyable, since this is a std::function
+    using Task = std::function<void()>;
+
+  private:
+    struct Queue {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+    // queues[0] is shared by outside threads, queues[i] belongs to worker i
+    std::vector<std::unique_ptr<Queue>> queues{};
+    std::vector<std::thread> workers{};
+    std::atomic<std::size_t> queued = 0;
+    bool stopping = false;
+    // guards stopping, and orders the wakeups against `queued`
+    std::mutex sleep_mutex{};
+    std::condition_variable wake{};
+
+    // the queue owned by the current thread, if it's one of our workers
+    static inline thread_local const ThreadPool *current_pool = nullptr;
+    static inline thread_local std::size_t current_queue = 0;
+
+    std::size_t home_queue() const {
+        return current_pool == this ? current_queue : 0;
+    }
+    bool pop_task(Task &task);
+    void worker_loop(std::size_t index);
+
+  public:
+    /**
+     * @brief  Create a pool for `num_threads` threads in total, counting the
+     *         thread that waits on the tasks (so this starts one fewer).
+     */
+    explicit ThreadPool(unsigned num_threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned num_threads() const { return workers.size() + 1; }
+
+    // queues a task, or runs it right away if there are no workers
+    void submit(Task task);
+    // runs one queued task from anywhere in the pool, if there are any
+    bool run_one();
+
+    static unsigned default_num_threads();
+    // shared by all the solutions
+    static ThreadPool &global();
+};
+
+inline ThreadPool::ThreadPool(unsigned num_threads) {
+    num_threads = std::max(num_threads, 1u);
+    for (unsigned i = 0; i < num_threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        workers.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{sleep_mutex};
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+inline void ThreadPool::submit(Task task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+    {
+        // count it first, so `queued` never drops below zero; a worker can't
+        // miss this between checking `queued` and going to sleep
+        std::lock_guard lock{sleep_mutex};
+        ++queued;
+    }
+    {
+        Queue &queue = *queues[home_queue()];
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+inline bool ThreadPool::pop_task(Task &task) {
+    const std::size_t home = home_queue();
+    for (std::size_t i = 0; i < queues.size(); ++i) {
+        Queue &queue = *queues[(home + i) % queues.size()];
+        std::lock_guard lock{queue.mutex};
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --queued;
+        return true;
+    }
+    return false;
+}
+
+inline bool ThreadPool::run_one() {
+    Task task;
+    if (!pop_task(task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+inline void ThreadPool::worker_loop(std::size_t index) {
+    current_pool = this;
+    current_queue = index;
+    while (true) {
+        if (run_one()) {
+            continue;
+        }
+        std::unique_lock lock{sleep_mutex};
+        wake.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+inline unsigned ThreadPool::default_num_threads() {
+    if (const char *value = std::getenv("AOC_THREADS")) {
+        const std::string_view arg{value};
+        unsigned num_threads = 0;
+        auto [ptr, ec] =
+            std::from_chars(arg.data(), arg.data() + arg.size(), num_threads);
+        if (ec == std::errc{} && ptr == arg.data() + arg.size() &&
+            num_threads >= 1) {
+            return num_threads;
+        }
+    }
+    if constexpr (aoc::DEBUG) {
+        // keep the debug output in order
+        return 1;
+    }
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+inline ThreadPool &ThreadPool::global() {
+    static ThreadPool pool{default_num_threads()};
+    return pool;
+}
+
+/**
+ * @brief  A set of tasks on a ThreadPool that can be waited on together.
+ *
+ * The first exception thrown by a task is rethrown from wait().
+ */
+class TaskGroup {
+    ThreadPool &pool;
+    std::atomic<std::size_t> pending = 0;
+    std::mutex error_mutex{};
+    std::exception_ptr error{};
+
+    void help_until_done() {
+        int idle_spins = 0;
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (pool.run_one()) {
+                idle_spins = 0;
+            } else if (++idle_spins < 64) {
+                std::this_thread::yield();
+            } else {
+                // the last tasks are running elsewhere; stop competing with
+                // them for a core
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+            }
+        }
+    }
+
+  public:
+    explicit TaskGroup(ThreadPool &pool = ThreadPool::global()) : pool(pool) {}
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+    // the tasks refer to the group, so it can't go away before they finish
+    ~TaskGroup() { help_until_done(); }
+
+    template <typename F>
+    void run(F &&func) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, func = std::forward<F>(func)]() mutable {
+            try {
+                func();
+            } catch (...) {
+                std::lock_guard lock{error_mutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    void wait() {
+        help_until_done();
+        if (error) {
+            std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    }
+};
+
+/**
+ * @brief  Call func(i) for every i in [begin, end).
+ *
+ * The range is split into chunks of `grain` indices, which each run as a
+ * task; pick a grain that makes a chunk worth at least a few microseconds.
+ */
+template <typename F>
+void parallel_for(std::size_t begin, std::size_t end, F func,
+                  std::size_t grain = 1,
+                  ThreadPool &pool = ThreadPool::global()) {
+    grain = std::max(grain, std::size_t{1});
+    if (pool.num_threads() == 1 || end <= begin + grain) {
+        for (std::size_t i = begin; i < end; ++i) {
+            func(i);
+        }
+        return;
+    }
+    TaskGroup group{pool};
+    for (std::size_t start = begin; start < end; start += grain) {
+        const std::size_t stop = std::min(end, start + grain);
+        group.run([&func, start, stop] {
+            for (std::size_t i = start; i < stop; ++i) {
+                func(i);
+            }
+        });
+    }
+    group.wait();
+}
+
+/**
+ * @brief  Fold map(i) for every i in [begin, end) together with reduce,
+ *         starting from identity.
+ *
+ * Each chunk of `grain` indices is folded in order, and then the chunks'
+ * results are, so the result doesn't depend on the number of threads (even
+ * if reduce isn't associative, like floating-point addition).
+ */
+template <typename T, typename Map, typename Reduce>
+T parallel_reduce(std::size_t begin, std::size_t end, T identity, Map map,
+                  Reduce reduce, std::size_t grain = 1,
+                  ThreadPool &pool = ThreadPool::global()) {
+    grain = std::max(grain, std::size_t{1});
+    if (end <= begin) {
+        return identity;
+    }
+    const std::size_t num_chunks = (end - begin + grain - 1) / grain;
+    // std::optional, so T doesn't need to be default constructible (and so
+    // it's never a std::vector<bool>)
+    std::vector<std::optional<T>> partials(num_chunks);
+    parallel_for(
+        0, num_chunks,
+        [&](std::size_t chunk) {
+            const std::size_t start = begin + chunk * grain;
+            const std::size_t stop = std::min(end, start + grain);
+            T result = identity;
+            for (std::size_t i = start; i < stop; ++i) {
+                result = reduce(std::move(result), map(i));
+            }
+            partials[chunk] = std::move(result);
+        },
+        1, pool);
+    T result = std::move(identity);
+    for (std::optional<T> &partial : partials) {
+        result = reduce(std::move(result), std::move(*partial));
+    }
+    return result;
+}
+
+/**
+ * @brief  A maximization problem for BranchAndBound.
+ *
+ * - value(state) is a score that's achievable from the state without
+ *   expanding it any further (e.g. by waiting until time runs out);
+ * - bound(state) is at least the value of anything reachable from it;
+ * - expand(state, push) calls push(child) for each successor, and states
+ *   with no successors are final.
+ */
+template <typename P>
+concept SearchProblem = requires(const P &problem,
+                                 const typename P::state_type &state) {
+    { problem.value(state) } -> std::convertible_to<int>;
+    { problem.bound(state) } -> std::convertible_to<int>;
+    problem.expand(state, [](const typename P::state_type &) {});
+};
+
+/**
+ * @brief  A 128-bit key, for search states that don't pack into 64 bits.
+ */
+struct WideKey {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+
+    bool operator==(const WideKey &) const = default;
+};
+
+} // namespace aoc
+
+template <>
+struct std::hash<aoc::WideKey> {
+    std::size_t operator()(const aoc::WideKey &key) const noexcept {
+        // Fibonacci hashing mixes the high word before it's folded in
+        return key.low ^ std::rotl(key.high * 0x9E3779B97F4A7C15ull, 32);
+    }
+};
+
+namespace aoc {
+
+/**
+ * @brief  A SearchProblem that can also detect duplicate states.
+ *
+ * States with equal key(state)s must have the same successors, up to their
+ * values, so only the one with the highest value needs to be kept. The key
+ * has to be exact: a collision can lose the optimum. It can be any type
+ * with a std::hash, like a std::uint64_t or a WideKey.
+ */
+template <typename P>
+concept KeyedSearchProblem =
+    SearchProblem<P> &&
+    requires(const P &problem, const typename P::state_type &state) {
+        {
+            std::hash<std::remove_cvref_t<decltype(problem.key(state))>>{}(
+                problem.key(state))
+        } -> std::convertible_to<std::size_t>;
+        { problem.key(state) == problem.key(state) } -> std::same_as<bool>;
+    };
+
+namespace detail {
+template <typename P>
+struct search_key {
+    using type = std::uint64_t;
+};
+template <KeyedSearchProblem P>
+struct search_key<P> {
+    using type = std::remove_cvref_t<decltype(std::declval<const P &>().key(
+        std::declval<const typename P::state_type &>()))>;
+};
+} // namespace detail
+
+enum class SearchStrategy {
+    // depth first, with the most promising children first
+    dfs,
+    // always expand the state with the highest bound, and stop once that
+    // can't beat the best value
+    best_first,
+    // breadth first, one layer (e.g. one minute) at a time
+    layered,
+    // layered, with each layer expanded in parallel
+    parallel_layered,
+};
+
+struct SearchOptions {
+    SearchStrategy strategy = SearchStrategy::layered;
+    // For layered search, the maximum number of states kept in each layer
+    // (those with the highest bounds), or 0 for no limit. Any limit trades
+    // accuracy for speed: the result is then only a lower bound.
+    std::size_t beam_width = 0;
+    // for parallel_layered, or nullptr for ThreadPool::global()
+    ThreadPool *pool = nullptr;
+
+    // Overrides the defaults with AOC_SEARCH (dfs, best_first, layered, or
+    // parallel_layered) and AOC_BEAM_WIDTH, if they're set.
+    static SearchOptions from_env(SearchOptions defaults);
+};
+
+inline SearchOptions SearchOptions::from_env(SearchOptions defaults) {
+    if (const char *value = std::getenv("AOC_SEARCH")) {
+        const std::string_view name{value};
+        if (name == "dfs") {
+            defaults.strategy = SearchStrategy::dfs;
+        } else if (name == "best_first") {
+            defaults.strategy = SearchStrategy::best_first;
+        } else if (name == "layered") {
+            defaults.strategy = SearchStrategy::layered;
+        } else if (name == "parallel_layered") {
+            defaults.strategy = SearchStrategy::parallel_layered;
+        } else {
+            throw std::invalid_argument("unknown AOC_SEARCH strategy: " +
+                                        std::string{name});
+        }
+    }
+    if (const char *value = std::getenv("AOC_BEAM_WIDTH")) {
+        defaults.beam_width = parse_int<std::size_t>(value);
+    }
+    return defaults;
+}
+
+/**
+ * @brief  Counts of what a BranchAndBound search did, for comparing
+ *         strategies and pruning rules.
+ */
+struct SearchStats {
+    long expanded = 0;
+    long generated = 0;
+    // states whose bound couldn't beat the best value found so far
+    long pruned_bound = 0;
+    // states with the same key as one that was at least as good
+    long pruned_duplicate = 0;
+    // states that didn't fit in the beam
+    long pruned_beam = 0;
+    // largest number of states waiting to be expanded at once
+    std::size_t max_frontier = 0;
+
+    SearchStats &operator+=(const SearchStats &other) {
+        expanded += other.expanded;
+        generated += other.generated;
+        pruned_bound += other.pruned_bound;
+        pruned_duplicate += other.pruned_duplicate;
+        pruned_beam += other.pruned_beam;
+        max_frontier = std::max(max_frontier, other.max_frontier);
+        return *this;
+    }
+
+    // how many states passed the bound for each one left after removing
+    // duplicates (1 if there were none)
+    double collapse_ratio() const {
+        const long candidates = generated - pruned_bound;
+        const long kept = candidates - pruned_duplicate;
+        return kept > 0 ? static_cast<double>(candidates) / kept : 1.0;
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const SearchStats &stats) {
+    os << stats.expanded << " expanded, " << stats.generated
+       << " generated, pruned " << stats.pruned_bound << " by bound, "
+       << stats.pruned_duplicate << " as duplicates (collapse ratio "
+       << stats.collapse_ratio() << "), " << stats.pruned_beam
+       << " by the beam; max frontier " << stats.max_frontier;
+    return os;
+}
+
+/**
+ * @brief  Branch-and-bound search for the highest value() reachable from an
+ *         initial state, with the strategy picked by SearchOptions.
+ *
+ * Any state whose bound can't beat the best value found so far is dropped,
+ * and for a KeyedSearchProblem, so is any state that a duplicate with at
+ * least the same value has already covered (within a layer for the layered
+ * strategies, or over the whole search otherwise). The buffers are kept
+ * between searches.
+ *
+ * parallel_layered splits each layer into fixed-size chunks, which expand into
+ * their own buffers while sharing the best value, so problem.expand() has to
+ * be safe to call concurrently. The chunks are merged in order, and only after
+ * the whole layer is done are the children filtered by bound and duplicates
+ * removed, so the result and the stats don't depend on the number of threads
+ * (even with a beam).
+ */
+template <SearchProblem Problem>
+class BranchAndBound {
+  public:
+    using state_type = typename Problem::state_type;
+
+  private:
+    struct Entry {
+        int bound;
+        state_type state;
+    };
+
+    const Problem &problem;
+    SearchOptions options;
+    SearchStats stats_{};
+    int best = 0;
+    std::vector<Entry> frontier{};
+    std::vector<Entry> next{};
+    // key -> the best value seen (dfs and best_first), or the index of the
+    // entry in next (layered)
+    std::unordered_map<typename detail::search_key<Problem>::type, int>
+        seen{};
+    // the children of each chunk of the frontier, for parallel_layered
+    std::vector<std::vector<Entry>> chunk_children{};
+    std::vector<SearchStats> chunk_stats{};
+
+    void start(const state_type &initial);
+    // Records the child's value, and returns its entry if it's still worth
+    // expanding; the duplicate check is up to the caller.
+    std::optional<Entry> consider(const state_type &child);
+    // returns true if a state with the same key was at least as good
+    bool seen_better(const state_type &state);
+    // adds a child to next, unless it's a duplicate of a better one there
+    void add_to_layer(Entry &&child);
+    void apply_beam();
+
+    int dfs();
+    int best_first();
+    int layered();
+    int parallel_layered();
+
+  public:
+    explicit BranchAndBound(const Problem &problem,
+                            SearchOptions options = SearchOptions{})
+        : problem(problem), options(options) {}
+
+    int run(const state_type &initial);
+    const SearchStats &stats() const { return stats_; }
+};
+
+template <SearchProblem Problem>
+void BranchAndBound<Problem>::start(const state_type &initial) {
+    stats_ = {};
+    frontier.clear();
+    next.clear();
+    seen.clear();
+    best = problem.value(initial);
+    frontier.push_back({problem.bound(initial), initial});
+    stats_.max_frontier = 1;
+}
+
+template <SearchProblem Problem>
+auto BranchAndBound<Problem>::consider(const state_type &child)
+    -> std::optional<Entry> {
+    ++stats_.generated;
+    best = std::max(best, static_cast<int>(problem.value(child)));
+    const int bound = problem.bound(child);
+    if (bound <= best) {
+        ++stats_.pruned_bound;
+        return std::nullopt;
+    }
+    return Entry{bound, child};
+}
+
+template <SearchProblem Problem>
+bool BranchAndBound<Problem>::seen_better(const state_type &state) {
+    if constexpr (KeyedSearchProblem<Problem>) {
+        const int value = problem.value(state);
+        auto [it, inserted] = seen.try_emplace(problem.key(state), value);
+        if (!inserted) {
+            if (it->second >= value) {
+                ++stats_.pruned_duplicate;
+                return true;
+            }
+            it->second = value;
+        }
+    }
+    return false;
+}
+
+template <SearchProblem Problem>
+int BranchAndBound<Problem>::run(const state_type &initial) {
+    start(initial);
+    switch (options.strategy) {
+    case SearchStrategy::dfs:
+        return dfs();
+    case SearchStrategy::best_first:
+        return best_first();
+    case SearchStrategy::layered:
+        return layered();
+    case SearchStrategy::parallel_layered:
+        return parallel_layered();
+    }
+    throw std::logic_error("unknown search strategy");
+}
+
+template <SearchProblem Problem>
+int BranchAndBound<Problem>::dfs() {
+    // frontier is the stack
+    while (!frontier.empty()) {
+        Entry entry = std::move(frontier.back());
+        frontier.pop_back();
+        if (entry.bound <= best) {
+            // the best value has improved since this was pushed
+            ++stats_.pruned_bound;
+            continue;
+        }
+        ++stats_.expanded;
+        const std::size_t first_child = frontier.size();
+        problem.expand(entry.state, [&](const state_type &child) {
+            if (auto child_entry = consider(child)) {
+                if (!seen_better(child)) {
+                    frontier.push_back(std::move(*child_entry));
+                }
+            }
+        });
+        // pop the child with the highest bound first
+        std::sort(frontier.begin() + first_child, frontier.end(),
+                  [](const Entry &a, const Entry &b) {
+                      return a.bound < b.bound;
+                  });
+        stats_.max_frontier = std::max(stats_.max_frontier, frontier.size());
+    }
+    return best;
+}
+
+template <SearchProblem Problem>
+int BranchAndBound<Problem>::best_first() {
+    // frontier is a max-heap on bound
+    constexpr auto cmp = [](const Entry &a, const Entry &b) {
+        return a.bound < b.bound;
+    };
+    while (!frontier.empty()) {
+        std::ranges::pop_heap(frontier, cmp);
+        Entry entry = std::move(frontier.back());
+        frontier.pop_back();
+        if (entry.bound <= best) {
+            // nothing left can do better
+            stats_.pruned_bound += 1 + frontier.size();
+            break;
+        }
+        ++stats_.expanded;
+        problem.expand(entry.state, [&](const state_type &child) {
+            if (auto child_entry = consider(child)) {
+                if (!seen_better(child)) {
+                    frontier.push_back(std::move(*child_entry));
+                    std::ranges::push_heap(frontier, cmp);
+                }
+            }
+        });
+        stats_.max_frontier = std::max(stats_.max_frontier, frontier.size());
+    }
+    return best;
+}
+
+template <SearchProblem Problem>
+int BranchAndBound<Problem>::layered() {
+    while (!frontier.empty()) {
+        next.clear();
+        seen.clear();
+        for (Entry &entry : frontier) {
+            if (entry.bound <= best) {
+                ++stats_.pruned_bound;
+                continue;
+            }
+            ++stats_.expanded;
+            problem.expand(entry.state, [&](const state_type &child) {
+                if (auto child_entry = consider(child)) {
+                    add_to_layer(std::move(*child_entry));
+                }
+            });
+        }
+        apply_beam();
+        std::swap(frontier, next);
+        stats_.max_frontier = std::max(stats_.max_frontier, frontier.size());
+    }
+    return best;
+}
+
+template <SearchProblem Problem>
+void BranchAndBound<Problem>::add_to_layer(Entry &&child) {
+    if constexpr (KeyedSearchProblem<Problem>) {
+        // keep the best of each set of duplicates in place
+        auto [it, inserted] =
+            seen.try_emplace(problem.key(child.state), next.size());
+        if (!inserted) {
+            ++stats_.pruned_duplicate;
+            Entry &other = next[it->second];
+            if (problem.value(other.state) < problem.value(child.state)) {
+                other = std::move(child);
+            }
+            return;
+        }
+    }
+    next.push_back(std::move(child));
+}
+
+template <SearchProblem Problem>
+void BranchAndBound<Problem>::apply_beam() {
+    if (options.beam_width > 0 && next.size() > options.beam_width) {
+        std::ranges::nth_element(next, next.begin() + options.beam_width,
+                                 [](const Entry &a, const Entry &b) {
+                                     return a.bound > b.bound;
+                                 });
+        stats_.pruned_beam += next.size() - options.beam_width;
+        next.erase(next.begin() + options.beam_width, next.end());
+    }
+}
+
+template <SearchProblem Problem>
+int BranchAndBound<Problem>::parallel_layered() {
+    // small enough to balance the load, but fixed so the merge order is too
+    constexpr std::size_t CHUNK_SIZE = 256;
+    ThreadPool &pool = options.pool ? *options.pool : ThreadPool::global();
+    std::atomic<int> shared_best = best;
+    while (!frontier.empty()) {
+        // every entry in the frontier beat the best value as of the last merge
+        const std::size_t num_chunks =
+            (frontier.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        if (chunk_children.size() < num_chunks) {
+            chunk_children.resize(num_chunks);
+        }
+        chunk_stats.assign(num_chunks, {});
+        parallel_for(
+            0, num_chunks,
+            [&](std::size_t chunk) {
+                std::vector<Entry> &children = chunk_children[chunk];
+                SearchStats &stats = chunk_stats[chunk];
+                children.clear();
+                const std::size_t stop =
+                    std::min(frontier.size(), (chunk + 1) * CHUNK_SIZE);
+                auto push = [&](const state_type &child) {
+                    ++stats.generated;
+                    const int value = problem.value(child);
+                    int current = shared_best.load(std::memory_order_relaxed);
+                    while (value > current &&
+                           !shared_best.compare_exchange_weak(
+                               current, value, std::memory_order_relaxed)) {
+                    }
+                    // an early cut, which only drops children that the merge
+                    // would anyway
+                    const int bound = problem.bound(child);
+                    if (bound <= std::max(value, current)) {
+                        ++stats.pruned_bound;
+                        return;
+                    }
+                    children.push_back({bound, child});
+                };
+                for (std::size_t i = chunk * CHUNK_SIZE; i < stop; ++i) {
+                    ++stats.expanded;
+                    problem.expand(frontier[i].state, push);
+                }
+            },
+            1, pool);
+        // the best value is now the same however the chunks ran
+        best = shared_best.load();
+        next.clear();
+        seen.clear();
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+            stats_ += chunk_stats[chunk];
+            for (Entry &child : chunk_children[chunk]) {
+                if (child.bound <= best) {
+                    ++stats_.pruned_bound;
+                    continue;
+                }
+                add_to_layer(std::move(child));
+            }
+        }
+        apply_beam();
+        std::swap(frontier, next);
+        stats_.max_frontier = std::max(stats_.max_frontier, frontier.size());
+    }
+    return best;
+}
+
+/**
+ * @brief  A day's entry point: solves the puzzle for the given input text,
+ *         and writes the answers to `out`.
+ */
+using solve_func = void (*)(std::string_view text, std::ostream &out);
+
+/**
+ * @brief  Every solution linked into this program, by day.
+ *
+ * Each day adds itself with a SolutionRegistrar at namespace scope, so
+ * linking a day's object file is enough to make it available.
+ */
+inline std::map<int, solve_func> &solutions() {
+    static std::map<int, solve_func> registry{};
+    return registry;
+}
+
+struct SolutionRegistrar {
+    SolutionRegistrar(int day, solve_func solve) {
+        if (!solutions().emplace(day, solve).second) {
+            throw std::logic_error("Tried to register a day twice");
+        }
+    }
+};
+
+/**
+ * @brief  Runs a solution on the input file named on the command line.
+ * @return The exit code for main().
+ */
+inline int run_solution(int argc, char **argv, solve_func solve) {
+    check_args(argc, argv);
+    std::optional<MappedInput> input{};
+    try {
+        input.emplace(argv[1]);
+    } catch (const std::system_error &e) {
+        std::cerr << "ERROR: could not read input file at " << argv[1] << ": "
+                  << e.what() << "\n";
+        return 2;
+    }
+    alloc::begin_solve();
+    solve(input->view(), std::cout);
+    alloc::end_solve();
+    instrument::report(std::cerr);
+    alloc::report(std::cerr);
+    return 0;
+}
+
+/**
+ * @brief  Path to an input file for a day, e.g. input/day07/input.txt.
+ */
+inline std::string input_path(int day, std::string_view input_name) {
+    std::string path = "input/day";
+    if (day < 10) {
+        path += '0';
+    }
+    path += std::to_string(day);
+    path += '/';
+    path += input_name;
+    return path;
+}
+
+/**
+ * @brief  Parse a day number from a command line argument.
+ * @return The day, or 0 if the argument isn't a number from 1 to 25.
+ */
+inline int parse_day(std::string_view arg) {
+    int day = 0;
+    auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), day);
+    if (ec != std::errc{} || ptr != arg.data() + arg.size() || day < 1 ||
+        day > 25) {
+        return 0;
+    }
+    return day;
+}
+
+namespace detail {
+// when the running solution last called mark_parsed()
+inline std::chrono::steady_clock::time_point parse_mark{};
+// called by mark_parsed() if set, so aoc_bench can snapshot other state there
+inline void (*parse_mark_hook)() = nullptr;
+} // namespace detail
+
+/**
+ * @brief  Mark the end of a solution's parsing phase.
+ *
+ * Solutions that read all of their input before solving call this in
+ * between, so aoc_bench can time the two phases separately. Solutions that
+ * parse as they go don't call it at all.
+ */
+inline void mark_parsed() {
+    detail::parse_mark = std::chrono::steady_clock::now();
+    alloc::mark_parsed();
+    if (detail::parse_mark_hook) {
+        detail::parse_mark_hook();
     }
-    return std::ifstream{argv[1]};
 }
 
 } // namespace aoc
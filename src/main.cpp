@@ -0,0 +1,21 @@
+/******************************************************************************
+ * File:        main.cpp
+ *
+ * Author:      yut23
+ * Created:     2026-10-16
+ * Description: Entry point for the per-day executables, each of which links
+ *              exactly one day's solution.
+ *****************************************************************************/
+
+#include "lib.h"
+#include <iostream> // for cerr
+
+int main(int argc, char **argv) {
+    const auto &solutions = aoc::solutions();
+    if (solutions.size() != 1) {
+        std::cerr << "Internal error: expected exactly one solution, found "
+                  << solutions.size() << std::endl;
+        return 1;
+    }
+    return aoc::run_solution(argc, argv, solutions.begin()->second);
+}
@@ -6,21 +6,23 @@
  *****************************************************************************/
 
 #include "lib.h"
-#include <iostream> // for cout
-#include <string>   // for string, getline
+#include <iostream>    // for ostream
+#include <string_view> // for string_view
 
-namespace aoc::day{{DAY}} {
+namespace aoc::day{{DAYNUM}} {
 
-} // namespace aoc::day{{DAY}}
-
-int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv);
+void solve(std::string_view text, std::ostream &out) {
+    aoc::InputView input{text};
 
     // read file line-by-line
-    std::string line;
-    while (std::getline(infile, line)) {
-        using namespace aoc::day{{DAY}};
+    std::string_view line;
+    while (input.next_line(line)) {
         // do stuff
     }
-    return 0;
+    aoc::mark_parsed();
+    out << std::endl;
 }
+
+const SolutionRegistrar registrar{{{DAYNUM}}, solve};
+
+} // namespace aoc::day{{DAYNUM}}
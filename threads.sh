@@ -0,0 +1,91 @@
+#!/bin/bash
+set -euo pipefail
+
+usage() {
+  echo "Usage: threads.sh [-t <thread counts>] [-n <runs>] [-e <example number>|-i <input file name>|-f <path>] <day>"
+}
+
+# cd to directory of this script (repository root)
+cd -- "$(dirname -- "${BASH_SOURCE[0]}")"
+source ./lib.sh
+
+thread_counts="1 2 4 8 16 32"
+runs=5
+input_name=input.txt
+input_file=
+day=
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    -t|--threads)
+      thread_counts=$2
+      shift
+      shift
+      ;;
+    -n|--runs)
+      runs=$2
+      shift
+      shift
+      ;;
+    -e|--example)
+      input_name=example$2.txt
+      shift
+      shift
+      ;;
+    -i|--input)
+      input_name=$2
+      shift
+      shift
+      ;;
+    -f|--file)
+      input_file=$2
+      shift
+      shift
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    -*)
+      echo "Error: unrecognized option '$1'"
+      usage
+      exit 1
+      ;;
+    *)
+      day=$(printf '%02d' "${1#0}")
+      shift
+      ;;
+  esac
+done
+if [[ -z $day ]]; then
+  usage
+  exit 1
+fi
+if [[ -z $input_file ]]; then
+  input_file=input/day$day/$input_name
+fi
+
+make_quiet build/fast/aoc_bench
+make_quiet "build/fast/day$day"
+
+json_file=$(mktemp)
+trap 'rm -f "$json_file"' EXIT
+
+# everything else (AOC_SEARCH, AOC_DAY16_ENGINE, ...) comes from the caller's
+# environment
+printf '%7s%12s%10s\n' threads 'time (ms)' speedup
+serial_time=
+serial_answer=
+for threads in $thread_counts; do
+  answer=$(AOC_THREADS=$threads "build/fast/day$day" "$input_file" 2>/dev/null)
+  AOC_THREADS=$threads build/fast/aoc_bench -n "$runs" -f "$input_file" -o "$json_file" "${day#0}" >/dev/null 2>&1
+  median=$(sed -ne 's/.*"total": {"min": [^,]*, "median": \([^,]*\),.*/\1/p' "$json_file")
+  if [[ -z $serial_time ]]; then
+    serial_time=$median
+    serial_answer=$answer
+  fi
+  awk -v t="$median" -v s="$serial_time" 'BEGIN { printf "%7d%12.3f%9.2fx", '"$threads"', t * 1000, s / t }'
+  if [[ $answer != "$serial_answer" ]]; then
+    printf '  MISMATCH: %s' "$(echo $answer)"
+  fi
+  printf '\n'
+done